@@ -0,0 +1,62 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <iostream>
+#include <cstring>
+
+#include "bench.h"
+
+/// benchmark entry: name, main function and description
+struct BenchEntry
+{
+	const char* name;
+	int (*run) ( int argc, char** argv );
+	const char* usage;
+};
+
+static const BenchEntry Benchmarks[] =
+{
+	{ "dag", dagBench, "dag [vertices [repeat%] [seed]]\t-- construction of a DAG with hash-consing" },
+	{ "depset", depSetBench, "depset [operations [max level [seed]]]\t-- union of dependency sets: list-based vs bit-vector ones" },
+	{ "reason", reasonBench, "reason [-r repeat] [-q queries] [-c config] [-o out.json] [-b baseline.json] [-t tolerance%] ontology.lisp ...\n"
+		"\t\t-- all reasoning phases for LISP ontologies; JSON results are compared with the baseline" },
+};
+
+static const unsigned int nBenchmarks = sizeof(Benchmarks)/sizeof(Benchmarks[0]);
+
+inline void Usage ( void )
+{
+	std::cerr << "\nUsage:\tFaCT++.Bench <benchmark> [args]\n\nwhere benchmark is one of:\n";
+	for ( unsigned int i = 0; i < nBenchmarks; ++i )
+		std::cerr << "\t" << Benchmarks[i].usage << "\n";
+	std::cerr << "\n";
+	exit(1);
+}
+
+int main ( int argc, char** argv )
+{
+	if ( argc < 2 )
+		Usage();
+
+	for ( unsigned int i = 0; i < nBenchmarks; ++i )
+		if ( strcmp ( argv[1], Benchmarks[i].name ) == 0 )
+			return Benchmarks[i].run ( argc-1, argv+1 );
+
+	Usage();
+	return 1;
+}
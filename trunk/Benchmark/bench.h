@@ -0,0 +1,56 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <cstdlib>
+
+/// get the numeric argument number N of the benchmark; DEF if there is no such argument
+inline unsigned long
+getArg ( int argc, char** argv, int n, unsigned long def )
+{
+	return n < argc ? strtoul ( argv[n], NULL, 10 ) : def;
+}
+
+/// simple linear congruential generator; the same on all platforms
+class TRandom
+{
+protected:	// members
+		/// current state
+	unsigned long long State;
+
+public:		// interface
+		/// init c'tor
+	explicit TRandom ( unsigned long long seed ) : State(seed*2862933555777941757ULL+3037000493ULL) {}
+		/// @return random number in [0,N)
+	unsigned int next ( unsigned int n )
+	{
+		State = State*6364136223846793005ULL + 1442695040888963407ULL;
+		return static_cast<unsigned int>(State >> 33) % n;
+	}
+}; // TRandom
+
+// defined in dagBench.cpp
+int dagBench ( int argc, char** argv );
+// defined in depSetBench.cpp
+int depSetBench ( int argc, char** argv );
+// defined in reasonBench.cpp
+int reasonBench ( int argc, char** argv );
+
+#endif
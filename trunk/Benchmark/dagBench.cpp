@@ -0,0 +1,128 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+
+#include <iostream>
+#include <vector>
+#include <sstream>
+
+#include "bench.h"
+#include "procTimer.h"
+#include "Kernel.h"
+#include "RoleMaster.h"
+#include "dlDag.h"
+
+/// description of a generated vertex: it could be re-created from it
+struct VertexSeed
+{
+		/// seed for the generator
+	unsigned long seed;
+		/// the vertex uses only DAG entries below this limit
+	unsigned int limit;
+		/// init c'tor
+	VertexSeed ( unsigned long s, unsigned int l ) : seed(s), limit(l) {}
+}; // VertexSeed
+
+/// build a complex vertex (AND, ALL or LE) described by S; @return NULL if the vertex is a clash
+static DLVertex*
+makeVertex ( const VertexSeed& s, const std::vector<TRole*>& Roles )
+{
+	TRandom rnd(s.seed);
+	// random entry (with polarity) from [2,limit)
+#	define RANDOM_BP() ( rnd.next(2) ? 1 : -1 ) * static_cast<BipolarPointer>(2 + rnd.next(s.limit-2))
+	DLVertex* v = NULL;
+	switch ( rnd.next(4) )
+	{
+	case 0:
+	case 1:
+	{
+		v = new DLVertex(dtAnd);
+		for ( unsigned int n = 2 + rnd.next(4); n > 0; --n )
+			if ( v->addChild(RANDOM_BP()) )
+			{
+				delete v;
+				return NULL;
+			}
+		break;
+	}
+	case 2:
+		v = new DLVertex ( dtForall, 0, Roles[rnd.next(Roles.size())], RANDOM_BP() );
+		break;
+	default:
+		v = new DLVertex ( dtLE, 1 + rnd.next(3), Roles[rnd.next(Roles.size())], RANDOM_BP() );
+		break;
+	}
+#	undef RANDOM_BP
+	return v;
+}
+
+/**
+ *	Build a DAG with a given number of complex vertices over a set of atomic
+ *	ones. The given percentage of the vertices repeat the already created
+ *	ones, so they are found in the DAG index.
+ */
+int dagBench ( int argc, char** argv )
+{
+	unsigned long nVertices = getArg ( argc, argv, 1, 1000000 );
+	unsigned long repeat = getArg ( argc, argv, 2, 30 );
+	unsigned long seed = getArg ( argc, argv, 3, 1 );
+	const unsigned int nAtoms = 1000, nRoles = 50;
+
+	ReasoningKernel Kernel;
+	RoleMaster ORM ( false, "*UROLE*", "*EROLE*" );
+	std::vector<TRole*> Roles;
+	for ( unsigned int i = 0; i < nRoles; ++i )
+	{
+		std::stringstream s;
+		s << "R" << i;
+		Roles.push_back(ORM.ensureRoleName(s.str()));
+	}
+
+	DLDag Dag(Kernel.getOptions());
+	for ( unsigned int i = 0; i < nAtoms; ++i )
+		Dag.directAdd(new DLVertex(dtNConcept));
+
+	TRandom rnd(seed);
+	std::vector<VertexSeed> Seeds;
+	Seeds.reserve(nVertices);
+	unsigned long nRepeated = 0;
+
+	TsProcTimer timer;
+	timer.Start();
+	for ( unsigned long i = 0; i < nVertices; ++i )
+	{
+		bool rep = !Seeds.empty() && rnd.next(100) < repeat;
+		VertexSeed s = rep ? Seeds[rnd.next(Seeds.size())] : VertexSeed ( rnd.next(0x7FFFFFFF), Dag.size() );
+		DLVertex* v = makeVertex ( s, Roles );
+		if ( v == NULL )
+			continue;
+		Dag.add(v);
+		if ( rep )
+			++nRepeated;
+		else
+			Seeds.push_back(s);
+	}
+	timer.Stop();
+
+	std::cout << "DAG construction: " << nVertices << " vertices (" << nRepeated << " repeated), final DAG size "
+			  << Dag.size() << "\nTime: " << (float)timer << " seconds";
+	if ( (float)timer > 0 )
+		std::cout << ", " << static_cast<unsigned long>(nVertices/(float)timer) << " vertices per second";
+	std::cout << "\n";
+	return 0;
+}
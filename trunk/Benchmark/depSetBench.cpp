@@ -0,0 +1,108 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "bench.h"
+#include "procTimer.h"
+#include "tDepSet.h"
+#include "tBitDepSet.h"
+
+/**
+ *	Run OPS random operations over a pool of dep-sets of type T, similar to
+ *	the ones done by the reasoner: unions of the dep-sets of clashing
+ *	entries, restricts on backtracking and checks of the latest level.
+ *	@return checksum of the results, to compare different implementations
+ */
+template<class T>
+static unsigned long long
+runDepSets ( TDepSetManager& Manager, unsigned long ops, unsigned int maxLevel, unsigned long seed, float& time )
+{
+	const unsigned int poolSize = 1024;
+	TRandom rnd(seed);
+	std::vector<T> Pool;
+	Pool.reserve(poolSize);
+	for ( unsigned int i = 0; i < poolSize; ++i )
+		Pool.push_back(T(Manager.get(rnd.next(maxLevel))));
+
+	unsigned long long sum = 0;
+	TsProcTimer timer;
+	timer.Start();
+	for ( unsigned long i = 0; i < ops; ++i )
+	{
+		T& ds = Pool[rnd.next(poolSize)];
+		switch ( rnd.next(8) )
+		{
+		case 0:	// backtrack
+			ds.restrict(rnd.next(maxLevel)+1);
+			break;
+		case 1:	// new branching point
+			ds = T(Manager.get(rnd.next(maxLevel)));
+			break;
+		case 2:
+			sum += ds.contains(rnd.next(maxLevel));
+			break;
+		default:	// clash
+			ds += Pool[rnd.next(poolSize)];
+			break;
+		}
+		sum += ds.level();
+	}
+	timer.Stop();
+	time = timer;
+	return sum;
+}
+
+/// print a single result
+static void
+printResult ( const char* name, float time, unsigned long ops )
+{
+	std::cout << name << ": " << time << " seconds";
+	if ( time > 0 )
+		std::cout << ", " << static_cast<unsigned long>(ops/time) << " operations per second";
+	std::cout << "\n";
+}
+
+/**
+ *	Compare list-based dep-sets with the ones that keep shallow levels in a
+ *	bit-vector on the same sequence of operations.
+ */
+int depSetBench ( int argc, char** argv )
+{
+	unsigned long ops = getArg ( argc, argv, 1, 10000000 );
+	unsigned int maxLevel = static_cast<unsigned int>(getArg ( argc, argv, 2, 48 ));
+	unsigned long seed = getArg ( argc, argv, 3, 1 );
+	if ( maxLevel == 0 )
+		maxLevel = 1;
+
+	TDepSetManager Manager(maxLevel);
+	float listTime = 0, bitTime = 0;
+	unsigned long long listSum = runDepSets<TDepSet> ( Manager, ops, maxLevel, seed, listTime );
+	unsigned long long bitSum = runDepSets<TBitDepSet> ( Manager, ops, maxLevel, seed, bitTime );
+
+	std::cout << "Dep-set operations: " << ops << ", levels [0," << maxLevel << ")\n";
+	printResult ( "list-based", listTime, ops );
+	printResult ( "bit-vector", bitTime, ops );
+	if ( listSum != bitSum )
+	{
+		std::cout << "Results differ: " << listSum << " vs " << bitSum << "\n";
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,392 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "bench.h"
+#include "procTimer.h"
+#include "configure.h"
+#include "parser.h"
+#include "Actor.h"
+
+/// reasoning statistic: counter name -> value
+typedef std::map<std::string, unsigned long> StatMap;
+
+/// measurements of a single phase of reasoning over a single ontology
+struct PhaseResult
+{
+		/// wall-clock time of every repetition
+	std::vector<double> wall;
+		/// CPU time of every repetition
+	std::vector<double> cpu;
+		/// peak RSS (in KB) over all repetitions
+	long peakRSS;
+		/// reasoner counters of the last repetition; the detailed tableau counters are there only if the kernel is built with USE_REASONING_STATISTICS
+	StatMap counters;
+		/// empty c'tor
+	PhaseResult ( void ) : peakRSS(0) {}
+}; // PhaseResult
+
+/// names of the phases in the order of execution; the preprocessing includes the consistency check
+static const char* PhaseNames[] = { "load", "preprocess", "classification", "realisation", "queries" };
+static const unsigned int nPhases = sizeof(PhaseNames)/sizeof(PhaseNames[0]);
+
+/// @return current wall-clock time in seconds
+static double
+getWallTime ( void )
+{
+	struct timeval tv;
+	gettimeofday ( &tv, NULL );
+	return tv.tv_sec + tv.tv_usec/1e6;
+}
+
+/// reset the peak RSS of the process if the OS allows it
+static void
+resetPeakRSS ( void )
+{
+#ifdef __linux__
+	std::ofstream o("/proc/self/clear_refs");
+	if ( o.good() )
+		o << "5";
+#endif
+}
+
+/// @return peak RSS of the process (in KB) since the last reset
+static long
+getPeakRSS ( void )
+{
+#ifdef __linux__
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while ( std::getline ( status, line ) )
+		if ( line.compare ( 0, 6, "VmHWM:" ) == 0 )
+			return atol ( line.c_str()+6 );
+#endif
+	struct rusage ru;
+	getrusage ( RUSAGE_SELF, &ru );
+	return ru.ru_maxrss;
+}
+
+/// @return median of the values in V
+static double
+median ( std::vector<double> v )
+{
+	if ( v.empty() )
+		return 0;
+	std::sort ( v.begin(), v.end() );
+	return v[v.size()/2];
+}
+
+/// @return names of all the user-defined entries found by ACTOR; inverse roles and top/bottom are skipped
+static std::vector<std::string>
+getNames ( const Actor& actor )
+{
+	Actor::Array1D found;
+	actor.getFoundData(found);
+	std::vector<std::string> ret;
+	for ( Actor::Array1D::const_iterator p = found.begin(), p_end = found.end(); p != p_end; ++p )
+		if ( !(*p)->isSystem() && !(*p)->isTop() && !(*p)->isBottom() && (*p)->getId() >= 0 )
+			ret.push_back((*p)->getName());
+	return ret;
+}
+
+/// run a query mix with at most MAXQUERIES queries over a realised KB; @return number of the queries
+static unsigned long
+runQueries ( ReasoningKernel& Kernel, unsigned long maxQueries )
+{
+	TExpressionManager* em = Kernel.getExpressionManager();
+	Actor actor;
+	actor.setInterruptAfterFirstFound(false);
+
+	// signature of the KB as it is known to the taxonomies
+	actor.needConcepts();
+	Kernel.getSubConcepts ( em->Top(), /*direct=*/false, actor );
+	std::vector<std::string> Concepts = getNames(actor);
+	actor.needObjectRoles();
+	Kernel.getSubRoles ( em->ObjectRoleTop(), /*direct=*/false, actor );
+	std::vector<std::string> Roles = getNames(actor);
+
+	unsigned long n = 0;
+	for ( size_t i = 0; i < Concepts.size() && n < maxQueries; ++i )
+	{
+		const TDLConceptExpression* C = em->Concept(Concepts[i]);
+		const TDLConceptExpression* D = em->Concept(Concepts[(i*7+1)%Concepts.size()]);
+
+		// hierarchy and instances of a named concept
+		actor.needConcepts();
+		Kernel.getSupConcepts ( C, /*direct=*/true, actor );
+		Kernel.getSubConcepts ( C, /*direct=*/true, actor );
+		actor.needIndividuals();
+		Kernel.getInstances ( C, actor );
+		n += 3;
+
+		if ( Roles.empty() )
+			continue;
+
+		// complex expressions: they require reasoning
+		const TDLConceptExpression* E = em->Exists ( em->ObjectRole(Roles[i%Roles.size()]), C );
+		Kernel.isSatisfiable(E);
+		Kernel.isSubsumedBy ( E, D );
+		actor.needConcepts();
+		Kernel.getSupConcepts ( E, /*direct=*/true, actor );
+		n += 3;
+	}
+	return n;
+}
+
+/// run all the phases for the ontology FILENAME; accumulate the results in PHASES
+static bool
+runOntology ( const char* filename, const Configuration* config, unsigned long maxQueries, std::vector<PhaseResult>& Phases )
+{
+	ReasoningKernel Kernel;
+	Kernel.setTopBottomRoleNames ( "*UROLE*", "*EROLE*", "*UDROLE*", "*EDROLE*" );
+	if ( config != NULL && Kernel.getOptions()->initByConfigure ( const_cast<Configuration&>(*config), "Tuning" ) )
+	{
+		std::cerr << "Cannot fill options value by config file\n";
+		return false;
+	}
+	Kernel.setOperationTimeout ( Kernel.getOptions()->getInt("testTimeout") );
+
+	std::ifstream in(filename);
+	if ( in.fail() )
+	{
+		std::cerr << "Cannot open input file '" << filename << "'\n";
+		return false;
+	}
+
+	bool consistent = true;
+	unsigned long nQueries = 0;
+	for ( unsigned int phase = 0; phase < nPhases; ++phase )
+	{
+		StatMap before;
+		Kernel.getReasoningStatistic(before);
+		resetPeakRSS();
+		TsProcTimer cpu;
+		double wall = getWallTime();
+		cpu.Start();
+
+		try
+		{
+			switch ( phase )
+			{
+			case 0: { DLLispParser parser ( &in, &Kernel ); parser.Parse(); break; }
+			case 1: consistent = Kernel.isKBConsistent(); break;
+			case 2: if ( consistent ) Kernel.classifyKB(); break;
+			case 3: if ( consistent ) Kernel.realiseKB(); break;
+			default: if ( consistent ) nQueries = runQueries ( Kernel, maxQueries ); break;
+			}
+		}
+		catch ( const EFPPInconsistentKB& )
+			{ consistent = false; }
+		catch ( const EFaCTPlusPlus& e )
+		{
+			std::cerr << filename << ": " << PhaseNames[phase] << " failed: " << e.what() << "\n";
+			return false;
+		}
+
+		cpu.Stop();
+		PhaseResult& result = Phases[phase];
+		result.wall.push_back(getWallTime()-wall);
+		result.cpu.push_back(cpu);
+		result.peakRSS = std::max ( result.peakRSS, getPeakRSS() );
+
+		// counters are the difference between the totals after and before the phase
+		StatMap after;
+		Kernel.getReasoningStatistic(after);
+		result.counters.clear();
+		for ( StatMap::const_iterator p = after.begin(), p_end = after.end(); p != p_end; ++p )
+			result.counters[p->first] = p->first == "maxGraphSize" ? p->second : p->second - before[p->first];
+	}
+	Phases[nPhases-1].counters["queries"] = nQueries;
+	if ( !consistent )
+		std::cerr << filename << ": KB is inconsistent; classification, realisation and queries were skipped\n";
+	return true;
+}
+
+/// @return string that represents S in JSON
+static std::string
+jsonString ( const std::string& s )
+{
+	std::string ret = "\"";
+	for ( std::string::const_iterator p = s.begin(), p_end = s.end(); p != p_end; ++p )
+		if ( *p == '"' || *p == '\\' )
+			ret += std::string("\\") + *p;
+		else
+			ret += *p;
+	return ret + "\"";
+}
+
+/// @return JSON value of a KEY in a single-line JSON object LINE; empty string if there is no such key
+static std::string
+getJSONValue ( const std::string& line, const std::string& key )
+{
+	size_t pos = line.find ( "\"" + key + "\":" );
+	if ( pos == std::string::npos )
+		return "";
+	pos += key.size() + 3;
+	while ( pos < line.size() && line[pos] == ' ' )
+		++pos;
+	if ( pos < line.size() && line[pos] == '"' )
+		return line.substr ( pos+1, line.find ( '"', pos+1 ) - pos - 1 );
+	size_t end = line.find_first_of ( ",}", pos );
+	return line.substr ( pos, end-pos );
+}
+
+/// print the result of a phase as a single-line JSON object
+static void
+printPhase ( std::ostream& o, const std::string& ontology, unsigned int phase, const PhaseResult& r )
+{
+	o << "{\"ontology\": " << jsonString(ontology) << ", \"phase\": \"" << PhaseNames[phase]
+	  << "\", \"repeat\": " << r.wall.size()
+	  << ", \"wall\": " << median(r.wall) << ", \"cpu\": " << median(r.cpu)
+	  << ", \"minWall\": " << *std::min_element ( r.wall.begin(), r.wall.end() )
+	  << ", \"peakRSS\": " << r.peakRSS << ", \"counters\": {";
+	for ( StatMap::const_iterator p = r.counters.begin(), p_end = r.counters.end(); p != p_end; ++p )
+		o << (p == r.counters.begin() ? "" : ", ") << jsonString(p->first) << ": " << p->second;
+	o << "}}";
+}
+
+/**
+ *	Compare the results in the file CURRENT with the ones in BASELINE.
+ *	@return the number of phases that became slower than allowed by TOLERANCE (in percents)
+ */
+static unsigned int
+compareWithBaseline ( const std::vector<std::string>& Current, const char* baseline, double tolerance )
+{
+	std::ifstream in(baseline);
+	if ( in.fail() )
+	{
+		std::cerr << "Cannot open baseline file '" << baseline << "'\n";
+		return 1;
+	}
+
+	// baseline wall time by ontology and phase
+	std::map<std::string, double> Base;
+	std::string line;
+	while ( std::getline ( in, line ) )
+		if ( !getJSONValue ( line, "phase" ).empty() )
+			Base[getJSONValue(line,"ontology") + ":" + getJSONValue(line,"phase")] = atof ( getJSONValue(line,"wall").c_str() );
+
+	// differences less than 10ms are treated as noise
+	const double minDiff = 0.01;
+	unsigned int nRegressions = 0;
+	for ( std::vector<std::string>::const_iterator p = Current.begin(), p_end = Current.end(); p != p_end; ++p )
+	{
+		std::string key = getJSONValue(*p,"ontology") + ":" + getJSONValue(*p,"phase");
+		std::map<std::string, double>::const_iterator b = Base.find(key);
+		if ( b == Base.end() )
+			continue;
+		double cur = atof ( getJSONValue(*p,"wall").c_str() );
+		if ( cur > b->second*(1+tolerance/100) && cur-b->second > minDiff )
+		{
+			std::cerr << "REGRESSION " << key << ": " << cur << "s vs baseline " << b->second << "s\n";
+			++nRegressions;
+		}
+		else
+			std::cerr << "ok " << key << ": " << cur << "s vs baseline " << b->second << "s\n";
+	}
+	return nRegressions;
+}
+
+/**
+ *	Run all the reasoning phases (load, preprocessing with the consistency check,
+ *	classification, realisation and a query mix) for the given LISP ontologies. Every ontology is
+ *	processed the given number of times; the results are printed as JSON and could
+ *	be compared with the previously saved ones.
+ */
+int reasonBench ( int argc, char** argv )
+{
+	unsigned long repeat = 3, maxQueries = 3000;
+	double tolerance = 10;
+	const char *output = NULL, *baseline = NULL;
+	Configuration config;
+	bool useConfig = false;
+	std::vector<const char*> Ontologies;
+
+	for ( int i = 1; i < argc; ++i )
+	{
+		bool hasValue = i+1 < argc;
+		if ( !strcmp ( argv[i], "-r" ) && hasValue )
+			repeat = getArg ( argc, argv, ++i, repeat );
+		else if ( !strcmp ( argv[i], "-q" ) && hasValue )
+			maxQueries = getArg ( argc, argv, ++i, maxQueries );
+		else if ( !strcmp ( argv[i], "-t" ) && hasValue )
+			tolerance = atof(argv[++i]);
+		else if ( !strcmp ( argv[i], "-o" ) && hasValue )
+			output = argv[++i];
+		else if ( !strcmp ( argv[i], "-b" ) && hasValue )
+			baseline = argv[++i];
+		else if ( !strcmp ( argv[i], "-c" ) && hasValue )
+		{
+			if ( config.Load(argv[++i]) )
+			{
+				std::cerr << "Cannot load config file '" << argv[i] << "'\n";
+				return 1;
+			}
+			useConfig = true;
+		}
+		else
+			Ontologies.push_back(argv[i]);
+	}
+	if ( Ontologies.empty() || repeat == 0 )
+	{
+		std::cerr << "No ontologies given\n";
+		return 1;
+	}
+
+	std::vector<std::string> Lines;
+	for ( std::vector<const char*>::const_iterator p = Ontologies.begin(), p_end = Ontologies.end(); p != p_end; ++p )
+	{
+		std::vector<PhaseResult> Phases(nPhases);
+		for ( unsigned long r = 0; r < repeat; ++r )
+			if ( !runOntology ( *p, useConfig ? &config : NULL, maxQueries, Phases ) )
+				return 1;
+		for ( unsigned int phase = 0; phase < nPhases; ++phase )
+		{
+			std::ostringstream o;
+			printPhase ( o, *p, phase, Phases[phase] );
+			Lines.push_back(o.str());
+		}
+	}
+
+	// the result is a JSON array with a single phase per line
+	std::ofstream file;
+	if ( output != NULL )
+		file.open(output);
+	std::ostream& o = output != NULL ? file : std::cout;
+	o << "[\n";
+	for ( size_t i = 0; i < Lines.size(); ++i )
+		o << Lines[i] << (i+1 < Lines.size() ? ",\n" : "\n");
+	o << "]\n";
+
+	if ( baseline == NULL )
+		return 0;
+	unsigned int nRegressions = compareWithBaseline ( Lines, baseline, tolerance );
+	if ( nRegressions > 0 )
+		std::cerr << nRegressions << " phase(s) are slower than the baseline by more than " << tolerance << "%\n";
+	return nRegressions > 0 ? 2 : 0;
+}
@@ -165,6 +165,17 @@ void fact_set_operation_timeout (fact_reasoning_kernel *k,
 	k->p->setOperationTimeout(timeout);
 }
 
+void fact_set_operation_wall_timeout (fact_reasoning_kernel *k,
+		unsigned long timeout)
+{
+	k->p->setOperationWallTimeout(timeout);
+}
+
+void fact_cancel_operation (fact_reasoning_kernel *k)
+{
+	k->p->cancelOperation();
+}
+
 int fact_new_kb (fact_reasoning_kernel *k)
 {
 	return k->p->newKB();
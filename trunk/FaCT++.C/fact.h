@@ -84,6 +84,11 @@ void fact_set_top_bottom_role_names (fact_reasoning_kernel *,
 
 void fact_set_operation_timeout (fact_reasoning_kernel *,
 		unsigned long timeout);
+/* set wall-clock timeout (in ms) for every reasoning operation; 0 means no timeout */
+void fact_set_operation_wall_timeout (fact_reasoning_kernel *,
+		unsigned long timeout);
+/* stop the reasoning operations in progress; could be called from any thread */
+void fact_cancel_operation (fact_reasoning_kernel *);
 
 int fact_new_kb (fact_reasoning_kernel *);
 int fact_release_kb (fact_reasoning_kernel *);
@@ -167,6 +167,30 @@ JNIEXPORT void JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_setOpe
 	getK(env,obj)->setOperationTimeout(delay > 0 ? static_cast<unsigned long>(delay) : 0);
 }
 
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    setOperationWallTimeout
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_setOperationWallTimeout
+(JNIEnv * env, jobject obj, jlong delay)
+{
+	TRACE_JNI("setOperationWallTimeout");
+	getK(env,obj)->setOperationWallTimeout(delay > 0 ? static_cast<unsigned long>(delay) : 0);
+}
+
+/*
+ * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
+ * Method:    cancelOperation
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_uk_ac_manchester_cs_factplusplus_FaCTPlusPlus_cancelOperation
+(JNIEnv * env, jobject obj)
+{
+	TRACE_JNI("cancelOperation");
+	getK(env,obj)->cancelOperation();
+}
+
 /*
  * Class:     uk_ac_manchester_cs_factplusplus_FaCTPlusPlus
  * Method:    setFreshEntityPolicy
@@ -169,6 +169,13 @@ void ThrowTO ( JNIEnv* env )
 	ThrowExc ( env, "Lorg/semanticweb/owlapi/reasoner/TimeOutException;" );
 }
 
+/// throw Reasoner Interrupted exception
+inline
+void ThrowRI ( JNIEnv* env )
+{
+	ThrowExc ( env, "Lorg/semanticweb/owlapi/reasoner/ReasonerInterruptedException;" );
+}
+
 /// field for Kernel's ID
 extern "C" jfieldID KernelFID;
 
@@ -23,6 +23,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "tJNICache.h"
 #include "JNIActor.h"
 #include "eFPPTimeout.h"
+#include "eFPPCancelled.h"
 #include "MemoryStat.h"
 
 #ifdef __cplusplus
@@ -43,6 +44,8 @@ extern "C" {
 	{ ThrowRIC ( env, cir.getRoleName() ); }	\
 	catch ( const EFPPTimeout& )				\
 	{ ThrowTO(env); }							\
+	catch ( const EFPPCancelled& )				\
+	{ ThrowRI(env); }							\
 	catch ( const EFaCTPlusPlus& fpp )			\
 	{ Throw ( env, fpp.what() ); }				\
 	catch ( const std::exception& ex )			\
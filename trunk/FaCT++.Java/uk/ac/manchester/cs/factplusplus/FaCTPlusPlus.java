@@ -558,6 +558,12 @@ public class FaCTPlusPlus {
 	// sets single operation timeout in milliseconds
 	public native void setOperationTimeout(long millis);
 
+	// sets wall-clock timeout of a reasoning operation in milliseconds
+	public native void setOperationWallTimeout(long millis);
+
+	// stops the reasoning operation in progress; could be called from any thread
+	public native void cancelOperation();
+
 	// sets single operation timeout in milliseconds
 	public native void setFreshEntityPolicy(boolean allowFresh);
 
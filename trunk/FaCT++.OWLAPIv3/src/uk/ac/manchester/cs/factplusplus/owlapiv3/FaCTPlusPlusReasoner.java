@@ -245,7 +245,7 @@ public class FaCTPlusPlusReasoner implements OWLReasoner, OWLOntologyChangeListe
 		long millis = configuration.getTimeOut();
 		if (millis == Long.MAX_VALUE)
 			millis = 0;
-		kernel.setOperationTimeout(millis);
+		kernel.setOperationWallTimeout(millis);
 		kernel.setFreshEntityPolicy(configuration.getFreshEntityPolicy() == FreshEntityPolicy.ALLOW);
 		loadReasonerAxioms();
 	}
@@ -334,6 +334,7 @@ public class FaCTPlusPlusReasoner implements OWLReasoner, OWLOntologyChangeListe
 
 	public void interrupt() {
 		interrupted.set(true);
+		kernel.cancelOperation();
 	}
 
 	// precompute inferences
@@ -16,12 +16,70 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#include <algorithm>
+
 #include "AtomicDecomposer.h"
 #include "logging.h"
 #include "ProgressIndicatorInterface.h"
 
 //#define RKG_DEBUG_AD
 
+//-------------------------------------------------------------
+// ParallelModuleBuilder
+//-------------------------------------------------------------
+
+ParallelModuleBuilder :: ParallelModuleBuilder ( const SigIndex* index, const AxiomVec& all, unsigned int maxId, ModuleType t, unsigned int nThreads )
+	: Pool(nThreads)
+	, Workers(nThreads)
+	, All(all)
+	, type(t)
+{
+	for ( unsigned int i = 0; i < nThreads; ++i )
+		Workers[i] = new TModularizer ( index, maxId );
+}
+
+ParallelModuleBuilder :: ~ParallelModuleBuilder ( void )
+{
+	// no worker should use its modularizer after that
+	Pool.stop();
+	for ( std::vector<TModularizer*>::iterator p = Workers.begin(), p_end = Workers.end(); p != p_end; ++p )
+		delete *p;
+}
+
+/// build modules for all the axioms of the current chunk
+void
+ParallelModuleBuilder :: run ( void )
+{
+	Modules.resize(Chunk.size());
+	Pool.run ( *this, Chunk.size() );
+}
+
+/// get the number of the locality checks made by all the workers
+unsigned long long
+ParallelModuleBuilder :: getNChecks ( void ) const
+{
+	unsigned long long ret = 0;
+	for ( std::vector<TModularizer*>::const_iterator p = Workers.begin(), p_end = Workers.end(); p != p_end; ++p )
+		ret += (*p)->getNChecks();
+	return ret;
+}
+
+/// build the module of an axiom number ITEM in the thread number WORKER
+void
+ParallelModuleBuilder :: process ( unsigned int worker, unsigned int item )
+{
+	TModularizer* Mod = Workers[worker];
+	if ( Bases[item] == NULL )
+		Mod->extractFromUsed ( All, Chunk[item]->getSignature(), type );
+	else
+		Mod->extract ( *Bases[item], Chunk[item]->getSignature(), type );
+	Modules[item] = Mod->getModule();
+}
+
+//-------------------------------------------------------------
+// AtomicDecomposer
+//-------------------------------------------------------------
+
 /// d'tor
 AtomicDecomposer :: ~AtomicDecomposer ( void )
 {
@@ -103,6 +161,82 @@ AtomicDecomposer :: createAtom ( TDLAxiom* ax, TOntologyAtom* parent )
 	return atom;
 }
 
+/// add axiom AX with the module MODULE to the atom with the same module; create such an atom if necessary; @return the new atom or NULL
+TOntologyAtom*
+AtomicDecomposer :: addToAtom ( TDLAxiom* ax, const AxiomVec& Module )
+{
+	// no empty modules should be here
+	fpp_assert ( !Module.empty() );
+	if ( PI )
+		PI->incIndicator();
+	// the module of an axiom contains the modules of all the axioms in it, so the same size means the same module
+	for ( AxiomVec::const_iterator q = Module.begin(), q_end = Module.end(); q != q_end; ++q )
+		if ( *q != ax && (*q)->getAtom() != NULL && (*q)->getAtom()->getModule().size() == Module.size() )
+		{
+			(*AOS)[(*q)->getAtom()->getId()]->addAxiom(ax);
+			return NULL;
+		}
+	// create new atom with that module
+	TOntologyAtom* atom = AOS->newAtom();
+	atom->setModule(Module);
+	atom->addAxiom(ax);
+	return atom;
+}
+
+/// create atoms for all the axioms of the ontology O building their modules in parallel
+void
+AtomicDecomposer :: createAtomsInParallel ( TOntology* O )
+{
+	// gather the axioms without atoms; the worker flags are indexed by the axiom ids
+	AxiomVec NoAtom;
+	unsigned int maxId = 0;
+	for ( TOntology::iterator p = O->begin(), p_end = O->end(); p != p_end; ++p )
+	{
+		if ( (*p)->getId() > maxId )
+			maxId = (*p)->getId();
+		if ( (*p)->isUsed() && (*p)->getAtom() == NULL )
+			NoAtom.push_back(*p);
+	}
+
+	ParallelModuleBuilder Builder ( pModularizer->getSigIndex(), O->getAxioms(), maxId+1, type, nThreads );
+	// the smallest known atom which module contains an axiom; its module is a search space for the axiom's one
+	std::vector<const TOntologyAtom*> Parent ( maxId+1, NULL );
+
+	// build the modules by chunks and merge them in the ontology order, so the atom ids and dependencies
+	// do not depend on the number of threads; small chunks allow to use the new atoms' modules as search spaces
+	const size_t chunkSize = 16*nThreads;
+	for ( size_t start = 0; start < NoAtom.size(); start += chunkSize )
+	{
+		Builder.clear();
+		for ( size_t i = start, i_end = std::min ( start + chunkSize, NoAtom.size() ); i < i_end; ++i )
+		{
+			const TOntologyAtom* parent = Parent[NoAtom[i]->getId()];
+			Builder.add ( NoAtom[i], parent ? &parent->getModule() : NULL );
+		}
+		Builder.run();
+		for ( unsigned int i = 0, n = Builder.size(); i < n; ++i )
+		{
+			TOntologyAtom* atom = addToAtom ( Builder.getAxiom(i), Builder.getModule(i) );
+			if ( atom == NULL )
+				continue;
+			// new atom: use its module for the axioms in it
+			for ( TOntologyAtom::AxiomSet::const_iterator q = atom->getModule().begin(), q_end = atom->getModule().end(); q != q_end; ++q )
+			{
+				const TOntologyAtom*& parent = Parent[(*q)->getId()];
+				if ( parent == NULL || parent->getModule().size() > atom->getModule().size() )
+					parent = atom;
+			}
+		}
+	}
+
+	// every atom depends on the atoms of all the axioms in its module
+	for ( AOStructure::iterator p = AOS->begin(), p_end = AOS->end(); p != p_end; ++p )
+		for ( TOntologyAtom::AxiomSet::const_iterator q = (*p)->getModule().begin(), q_end = (*p)->getModule().end(); q != q_end; ++q )
+			(*p)->addDepAtom ( (*AOS)[(*q)->getAtom()->getId()] );
+
+	nWorkerChecks += Builder.getNChecks();
+}
+
 /// get the atomic structure for given module type T
 AOStructure*
 AtomicDecomposer :: getAOS ( TOntology* O, ModuleType t )
@@ -131,9 +265,12 @@ AtomicDecomposer :: getAOS ( TOntology* O, ModuleType t )
 			BottomAtom->addAxiom(*q);
 
 	// create atoms for all the axioms in the ontology
-	for ( TOntology::iterator p = O->begin(), p_end = O->end(); p != p_end; ++p )
-		if ( (*p)->isUsed() && (*p)->getAtom() == NULL )
-			createAtom ( *p, rootAtom );
+	if ( nThreads > 1 )
+		createAtomsInParallel(O);
+	else
+		for ( TOntology::iterator p = O->begin(), p_end = O->end(); p != p_end; ++p )
+			if ( (*p)->isUsed() && (*p)->getAtom() == NULL )
+				createAtom ( *p, rootAtom );
 
 	// restore tautologies in the ontology
 	restoreTautologies();
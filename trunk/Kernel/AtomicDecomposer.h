@@ -22,6 +22,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "tOntologyAtom.h"
 #include "tSignature.h"
 #include "Modularity.h"
+#include "tWorkerPool.h"
 
 class ProgressIndicatorInterface;
 
@@ -76,6 +77,61 @@ public:		// interface
 	size_t size ( void ) const { return Atoms.size(); }
 }; // AOStructure
 
+/**
+ *	Builds the modules of a chunk of axioms in a pool of threads. Every
+ *	thread has its own modularizer with the syntactic locality checker and
+ *	its own in-module and in-search-space flags; all of them share the
+ *	(read-only) sig index of the main modularizer.
+ */
+class ParallelModuleBuilder: public TWorkerPool::Job
+{
+protected:	// members
+		/// pool of the worker threads
+	TWorkerPool Pool;
+		/// modularizer for every worker
+	std::vector<TModularizer*> Workers;
+		/// all the used axioms of the ontology (the search space)
+	const AxiomVec& All;
+		/// current chunk of axioms
+	AxiomVec Chunk;
+		/// search space for every axiom of the chunk; NULL means all the used axioms
+	std::vector<const AxiomVec*> Bases;
+		/// modules of the axioms of the current chunk
+	std::vector<AxiomVec> Modules;
+		/// module type
+	ModuleType type;
+
+private:	// no copy
+		/// no copy c'tor
+	ParallelModuleBuilder ( const ParallelModuleBuilder& );
+		/// no assignment
+	ParallelModuleBuilder& operator = ( const ParallelModuleBuilder& );
+
+public:		// interface
+		/// c'tor: create NTHREADS workers sharing the sig INDEX for TYPE-modules of the used axioms ALL; ids of the axioms are less than MAXID
+	ParallelModuleBuilder ( const SigIndex* index, const AxiomVec& all, unsigned int maxId, ModuleType t, unsigned int nThreads );
+		/// d'tor: stop all the workers
+	virtual ~ParallelModuleBuilder ( void );
+
+		/// add axiom AX to the current chunk; use BASE as a search space for its module if it is not NULL
+	void add ( TDLAxiom* ax, const AxiomVec* base ) { Chunk.push_back(ax); Bases.push_back(base); }
+		/// get the number of axioms in the current chunk
+	unsigned int size ( void ) const { return Chunk.size(); }
+		/// get the I-th axiom of the current chunk
+	TDLAxiom* getAxiom ( unsigned int i ) const { return Chunk[i]; }
+		/// build modules for all the axioms of the current chunk
+	void run ( void );
+		/// forget the current chunk
+	void clear ( void ) { Chunk.clear(); Bases.clear(); }
+		/// get the module of the I-th axiom of the current chunk
+	const AxiomVec& getModule ( unsigned int i ) const { return Modules[i]; }
+		/// get the number of the locality checks made by all the workers
+	unsigned long long getNChecks ( void ) const;
+
+		/// build the module of an axiom number ITEM in the thread number WORKER
+	virtual void process ( unsigned int worker, unsigned int item );
+}; // ParallelModuleBuilder
+
 /// atomical decomposer of the ontology
 class AtomicDecomposer
 {
@@ -92,6 +148,10 @@ protected:	// members
 	TOntologyAtom* rootAtom;
 		/// module type for current AOS creation
 	ModuleType type;
+		/// number of threads to build the modules; 1 means the main thread only
+	unsigned int nThreads;
+		/// number of the locality checks made by the parallel workers
+	unsigned long long nWorkerChecks;
 
 protected:	// methods
 		/// remove tautologies (axioms that are always local) from the ontology temporarily
@@ -106,10 +166,14 @@ protected:	// methods
 	TOntologyAtom* buildModule ( const TSignature& sig, TOntologyAtom* parent );
 		/// create atom for given axiom AX; use parent atom's module as a base for the module search
 	TOntologyAtom* createAtom ( TDLAxiom* ax, TOntologyAtom* parent );
+		/// add axiom AX with the module MODULE to the atom with the same module; create such an atom if necessary; @return the new atom or NULL
+	TOntologyAtom* addToAtom ( TDLAxiom* ax, const AxiomVec& Module );
+		/// create atoms for all the axioms of the ontology O building their modules in parallel
+	void createAtomsInParallel ( TOntology* O );
 
 public:		// interface
 		/// init c'tor; M would NOT be deleted in d'tor
-	AtomicDecomposer ( TModularizer* m ) : AOS(NULL), pModularizer(m), PI(NULL), rootAtom(NULL) {}
+	AtomicDecomposer ( TModularizer* m ) : AOS(NULL), pModularizer(m), PI(NULL), rootAtom(NULL), nThreads(1), nWorkerChecks(0) {}
 		/// d'tor
 	~AtomicDecomposer ( void );
 
@@ -120,8 +184,10 @@ public:		// interface
 
 		/// set progress indicator to be PI
 	void setProgressIndicator ( ProgressIndicatorInterface* pi ) { PI = pi; }
+		/// set the number of threads to build the modules; the modularizer should use the syntactic locality if N > 1
+	void setNThreads ( unsigned int n ) { nThreads = n > 1 ? n : 1; }
 		/// get number of performed locality checks
-	unsigned long long getLocChekNumber ( void ) const { return pModularizer->getNChecks(); }
+	unsigned long long getLocChekNumber ( void ) const { return pModularizer->getNChecks() + nWorkerChecks; }
 }; // AtomicDecomposer
 
 #endif
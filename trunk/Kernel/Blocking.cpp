@@ -16,6 +16,8 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#include <algorithm>
+
 #include "dlDag.h"
 #include "dlCompletionGraph.h"
 #include "Reasoner.h"
@@ -426,20 +428,82 @@ void DlCompletionGraph :: findDAncestorBlocker ( DlCompletionTree* node )
 	}
 }
 
-void DlCompletionGraph :: findDAnywhereBlocker ( DlCompletionTree* node )
+/// order nodes by their IDs
+class TNodeIdLess
+{
+public:
+	bool operator() ( const DlCompletionTree* p, const DlCompletionTree* q ) const { return p->getId() < q->getId(); }
+}; // TNodeIdLess
+
+void
+DlCompletionGraph :: buildLabelIndex ( void )
 {
-	for ( const_iterator q = begin(), q_end = end(); q < q_end && *q != node; ++q )
+	useLabelIndex = true;
+	DlCompletionTree::const_label_iterator p, p_end;
+	for ( iterator q = begin(), q_end = end(); q < q_end; ++q )
 	{
-		const DlCompletionTree* p = *q;
+		for ( p = (*q)->beginl_sc(), p_end = (*q)->endl_sc(); p < p_end; ++p )
+			addToLabelIndex ( *q, p->bp() );
+		for ( p = (*q)->beginl_cc(), p_end = (*q)->endl_cc(); p < p_end; ++p )
+			addToLabelIndex ( *q, p->bp() );
+	}
+}
 
-		// node was merge to smth with the larger ID or is cached or blocked itself
-		if ( p->isBlocked() || p->isPBlocked() || p->isNominalNode() || p->isCached() )
-			continue;
+const DlCompletionGraph::nodeBaseType*
+DlCompletionGraph :: getBlockerCandidates ( const DlCompletionTree* node, BipolarPointer& bp )
+{
+	// every blocker contains the whole label of a node, so use the concept that is in the least number of labels
+	bp = bpINVALID;
+	size_t best = 0;
+	DlCompletionTree::const_label_iterator p, p_end;
+	for ( p = node->beginl_sc(), p_end = node->endl_sc(); p < p_end; ++p )
+		if ( bp == bpINVALID || LabelIndex[getLabelIndexKey(p->bp())].Nodes.size() < best )
+			best = LabelIndex[getLabelIndexKey(bp = p->bp())].Nodes.size();
+	for ( p = node->beginl_cc(), p_end = node->endl_cc(); p < p_end; ++p )
+		if ( bp == bpINVALID || LabelIndex[getLabelIndexKey(p->bp())].Nodes.size() < best )
+			best = LabelIndex[getLabelIndexKey(bp = p->bp())].Nodes.size();
+
+	if ( bp == bpINVALID )
+		return NULL;
+
+	LabelIndexEntry& entry = LabelIndex[getLabelIndexKey(bp)];
+	if ( !entry.Sorted )
+	{
+		// remove the nodes that are dead or lost BP after backtracking
+		nodeBaseType& nodes = entry.Nodes;
+		iterator q = nodes.begin(), q_end = nodes.end(), r = q;
+		for ( ; q != q_end; ++q )
+			if ( (*q)->getId() < endUsed && (*q)->label().contains(bp) )
+				*r++ = *q;
+		nodes.erase ( r, q_end );
+
+		// sort in the order of creation; remove nodes that got BP several times
+		std::sort ( nodes.begin(), nodes.end(), TNodeIdLess() );
+		nodes.erase ( std::unique ( nodes.begin(), nodes.end() ), nodes.end() );
+		entry.Sorted = true;
+	}
+	return &entry.Nodes;
+}
 
-		if ( isBlockedBy ( node, p ) )
-		{
-			setNodeDBlocked ( node, p );
-			return;
-		}
+void DlCompletionGraph :: findDAnywhereBlocker ( DlCompletionTree* node )
+{
+	++nBlockerSearches;
+	if ( !useLabelIndex && endUsed >= minIndexedGraphSize() )
+		buildLabelIndex();
+
+	BipolarPointer bp = bpINVALID;
+	const nodeBaseType* candidates = useLabelIndex ? getBlockerCandidates ( node, bp ) : NULL;
+
+	if ( candidates == NULL )	// small graph or empty label: check every node created before NODE
+	{
+		for ( const_iterator q = begin(), q_end = end(); q < q_end && *q != node; ++q )
+			if ( tryBlocker ( node, *q ) )
+				return;
+		return;
 	}
+
+	for ( const_iterator q = candidates->begin(), q_end = candidates->end(); q < q_end && (*q)->getId() < node->getId(); ++q )
+		// node lost the concept after backtracking
+		if ( (*q)->label().contains(bp) && tryBlocker ( node, *q ) )
+			return;
 }
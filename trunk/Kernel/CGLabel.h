@@ -131,12 +131,10 @@ public:		// interface
 		/// get CC offset of a complex concept BP that appears in the label
 	int getCCOffset ( BipolarPointer bp ) const
 	{
-		for ( const_iterator p = begin_cc(), p_end = end_cc(); p < p_end; ++p )
-			if ( *p == bp )
-				return getCCOffset(p);
+		int n = ccLabel.index(bp);
 		// BP should appear in the label
-		fpp_unreachable();
-		return 0;
+		fpp_assert ( n >= 0 );
+		return -(n+1);
 	}
 
 	// check if node is labelled by given concept
@@ -42,20 +42,71 @@ CWDArray :: updateDepSet ( BipolarPointer bp, const DepSet& dep )
 	if ( dep.empty() )
 		return NULL;
 
-	for ( iterator i = Base.begin(), i_end = Base.end(); i < i_end; ++i )
-		if ( i->bp() == bp )
-		{
-			TRestorer* ret = new UnMerge ( *this, i );
-//			DepSet odep(i->getDep());
-			i->addDep(dep);
-/*			if ( odep == i->getDep() )
-			{
-				delete ret;
-				ret = NULL;
-			}*/
-			return ret;
-		}
-	return NULL;
+	int n = index(bp);
+	if ( n < 0 )
+		return NULL;
+
+	iterator i = Base.begin() + n;
+	TRestorer* ret = new UnMerge ( *this, i );
+//	DepSet odep(i->getDep());
+	i->addDep(dep);
+/*	if ( odep == i->getDep() )
+	{
+		delete ret;
+		ret = NULL;
+	}*/
+	return ret;
+}
+
+void
+CWDArray :: buildIndex ( void )
+{
+	size_t size = 64;
+	while ( size < 4*Base.size() )
+		size *= 2;
+	Index.assign ( size, 0 );
+	for ( size_t pos = 0, n = Base.size(); pos < n; ++pos )
+		indexAdd(pos);
+}
+
+void
+CWDArray :: indexAdd ( size_t pos )
+{
+	// keep the load factor below 1/2
+	if ( 2*(pos+1) > Index.size() )
+	{
+		buildIndex();
+		return;
+	}
+	BipolarPointer bp = Base[pos].bp();
+	unsigned int i = slot(bp);
+	for ( ; Index[i] != 0; i = (i+1) & (Index.size()-1) )
+		if ( Base[Index[i]-1].bp() == bp )	// keep the first occurrence only
+			return;
+	Index[i] = pos+1;
+}
+
+void
+CWDArray :: indexRemove ( size_t pos )
+{
+	const unsigned int mask = Index.size()-1;
+	unsigned int i = slot(Base[pos].bp());
+	for ( ; Index[i] != pos+1; i = (i+1) & mask )
+		if ( Index[i] == 0 )	// not indexed (duplicate entry)
+			return;
+
+	// remove the entry and move the rest of the cluster to fill the gap
+	Index[i] = 0;
+	for ( unsigned int j = (i+1) & mask; Index[j] != 0; j = (j+1) & mask )
+	{
+		unsigned int k = slot(Base[Index[j]-1].bp());
+		// entry J stays if its initial slot K is cyclically in (I,J]
+		if ( i <= j ? ( i < k && k <= j ) : ( i < k || k <= j ) )
+			continue;
+		Index[i] = Index[j];
+		Index[j] = 0;
+		i = j;
+	}
 }
 
 /// restore label to given LEVEL using given SS
@@ -63,6 +114,9 @@ void
 CWDArray :: restore ( const SaveState& ss, unsigned int level ATTR_UNUSED )
 {
 #ifndef RKG_USE_DYNAMIC_BACKJUMPING
+	if ( !Index.empty() )
+		for ( size_t k = Base.size(); k > ss.ep; --k )
+			indexRemove(k-1);
 	Base.resize(ss.ep);
 #else
 	unsigned int j = ss.ep;
@@ -78,7 +132,9 @@ CWDArray :: restore ( const SaveState& ss, unsigned int level ATTR_UNUSED )
 		}
 	}
 
-	Base.reset(j);
+	Base.resize(j);
+	if ( !Index.empty() )
+		buildIndex();
 #endif
 }
 
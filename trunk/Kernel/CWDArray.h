@@ -20,7 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #define CWDARRAY_H
 
 #include <ostream>
-#include <algorithm>	// find
+#include <vector>
 
 #include "globaldef.h"
 #include "growingArray.h"
@@ -62,9 +62,30 @@ public:		// type interface
 		/// const iterator on label
 	typedef ConceptSet::const_iterator const_iterator;
 
+		/// hash index of a label: position+1 of a concept in a label, or 0 for an empty slot
+	typedef std::vector<unsigned int> IndexTable;
+
 protected:	// members
 		/// array of concepts together with dep-sets
 	ConceptSet Base;
+		/// membership index of a large label; empty while the label is small
+	IndexTable Index;
+
+protected:	// methods
+		/// labels with at least this many concepts get the membership index
+	static unsigned int indexThreshold ( void ) { return 16; }
+		/// @return the initial slot of BP in the index
+	unsigned int slot ( BipolarPointer bp ) const
+	{
+		unsigned int h = static_cast<unsigned int>(bp) * 2654435761U;
+		return ( h ^ (h >> 16) ) & (Index.size()-1);
+	}
+		/// (re-)build the index of all the concepts of the label
+	void buildIndex ( void );
+		/// add the concept at the position POS to the index
+	void indexAdd ( size_t pos );
+		/// remove the concept at the position POS from the index
+	void indexRemove ( size_t pos );
 
 public:		// interface
 		/// init/clear label with given size
@@ -72,13 +93,14 @@ public:		// interface
 	{
 		Base.reserve(size);
 		Base.clear();
+		Index.clear();
 	}
 		/// empty c'tor
 	CWDArray ( void ) {}
 		/// copy c'tor
-	CWDArray ( const CWDArray& copy ) : Base(copy.Base) {}
+	CWDArray ( const CWDArray& copy ) : Base(copy.Base), Index(copy.Index) {}
 		/// assignment
-	CWDArray& operator = ( const CWDArray& copy ) { Base = copy.Base; return *this; }
+	CWDArray& operator = ( const CWDArray& copy ) { Base = copy.Base; Index = copy.Index; return *this; }
 		/// empty d'tor
 	~CWDArray ( void ) {}
 
@@ -97,14 +119,42 @@ public:		// interface
 	// add concept
 
 		/// adds concept P to a label
-	void add ( const ConceptWDep& p ) { Base.add(p); }
+	void add ( const ConceptWDep& p )
+	{
+		Base.add(p);
+		if ( !Index.empty() )
+			indexAdd(Base.size()-1);
+		else if ( Base.size() >= indexThreshold() )
+			buildIndex();
+	}
 		/// update concept BP with a dep-set DEP; @return the appropriate restorer
 	TRestorer* updateDepSet ( BipolarPointer bp, const DepSet& dep );
 
 	// access concepts
 
 		/// check whether label contains BP (ignoring dep-set)
-	bool contains ( BipolarPointer bp ) const { return std::find ( begin(), end(), bp ) != end(); }
+	bool contains ( BipolarPointer bp ) const { return index(bp) >= 0; }
+		/// get the concept BP from the label; @return NULL if BP is not in the label
+	const ConceptWDep* get ( BipolarPointer bp ) const
+	{
+		int n = index(bp);
+		return n < 0 ? NULL : &Base[n];
+	}
+		/// get the index of the concept BP in the label; @return -1 if BP is not in the label
+	int index ( BipolarPointer bp ) const
+	{
+		if ( Index.empty() )
+		{
+			for ( const_iterator p = begin(), p_end = end(); p < p_end; ++p )
+				if ( p->bp() == bp )
+					return p - begin();
+			return -1;
+		}
+		for ( unsigned int i = slot(bp); Index[i] != 0; i = (i+1) & (Index.size()-1) )
+			if ( Base[Index[i]-1].bp() == bp )
+				return Index[i]-1;
+		return -1;
+	}
 		/// get the concept by given index in the node's label
 	const ConceptWDep& getConcept ( int n ) const { return Base[n]; }
 
@@ -42,6 +42,8 @@ public:		// methods
 	ConceptWDep ( const ConceptWDep& c ) : Concept(c.Concept), depSet(c.depSet) {}
 		/// copy c'tor with additional dep-set
 	ConceptWDep ( const ConceptWDep& c, const DepSet& dep ) : Concept(c.Concept), depSet(c.depSet) { depSet.add(dep); }
+		/// assignment
+	ConceptWDep& operator = ( const ConceptWDep& c ) { Concept = c.Concept; depSet = c.depSet; return *this; }
 
 	// comparison
 
@@ -216,6 +216,8 @@ TBox :: answerQuery ( const std::vector<DLTree*>& Cs )
 		AllInd.push_back(*i);
 
 	std::cout << " done with " << AllInd.size() << " individuals" << std::endl;
+	// the query could relate individuals of different ABox components
+	prepareNominalCloud ( NULL, NULL );
 	size_t size = Cs.size();
 
 	std::cout << "Creating iterables...";
@@ -25,8 +25,12 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "procTimer.h"
 #include "globaldef.h"
 #include "logging.h"
+#include "tCostProfile.h"
+#include "ParallelCacheBuilder.h"
+#include "tABoxPartition.h"
 
 #include <queue>
+#include <algorithm>
 
 /********************************************************\
 |* 			Implementation of class Taxonomy			*|
@@ -53,6 +57,19 @@ bool DLConceptTaxonomy :: testSub ( const TConcept* p, const TConcept* q )
 	if ( LLM.isWritable(llTaxTrying) )
 		LL << "\nTAX: trying '" << p->getName() << "' [= '" << q->getName() << "'... ";
 
+	if ( q->getEntity() != NULL && tBox.isELFComplete(p) )
+	{
+		bool res = tBox.isELFSubHolds ( p, q );
+		if ( LLM.isWritable(llTaxTrying) )
+			LL << ( res ? "holds" : "NOT holds" ) << " (EL result)";
+
+		if ( res )
+			++nELFPositive;
+		else
+			++nELFNegative;
+		return res;
+	}
+
 	if ( tBox.testSortedNonSubsumption ( p, q ) )
 	{
 		if ( LLM.isWritable(llTaxTrying) )
@@ -97,6 +114,22 @@ bool DLConceptTaxonomy :: testSub ( const TConcept* p, const TConcept* q )
 	return testSubTBox ( p, q );
 }
 
+bool
+DLConceptTaxonomy :: needTableauTest ( const TConcept* p, const TConcept* q )
+{
+	// the same checks as in testSub()
+	if ( q->isSingleton() && q->isPrimitive() && !q->isNominal() )
+		return false;
+	if ( q->getEntity() != NULL && tBox.isELFComplete(p) )
+		return false;
+	if ( tBox.testSortedNonSubsumption ( p, q ) )
+		return false;
+	if ( isNotInModule(q->getEntity()) )
+		return false;
+	modelCacheState state = tBox.testCachedNonSubsumption ( p, q );
+	return state != csValid && state != csInvalid;
+}
+
 bool
 DLConceptTaxonomy :: isNotInModule ( const TNamedEntity* entity ) const
 {
@@ -141,14 +174,75 @@ void DLConceptTaxonomy :: print ( std::ostream& o ) const
 		o << "Sorted reasoning deals with " << nSortedNegative << " non-subsumptions\n";
 	if ( nModuleNegative )
 		o << "Modular reasoning deals with " << nModuleNegative << " non-subsumptions\n";
+	if ( nELFPositive || nELFNegative )
+		o << "EL saturation deals with " << nELFPositive << " subsumptions and " << nELFNegative << " non-subsumptions\n";
 	o << "There were made " << nSearchCalls << " search calls\nThere were made " << nSubCalls
 	  << " Sub calls, of which " << nNonTrivialSubCalls << " non-trivial\n";
 	o << "Current efficiency (wrt Brute-force) is " << nEntries*(nEntries-1)/n << "\n";
+	if ( pParallel && pParallel->getNParallelTests() )
+		o << pParallel->getNParallelTests() << " subsumption tests were made in " << pParallel->getNThreads() << " threads\n";
+	if ( pParallel && pParallel->getNDroppedTests() )
+		o << pParallel->getNDroppedTests() << " subsumption tests failed in the threads and were re-done serially\n";
+	if ( nParallelCaches )
+		o << nParallelCaches << " caches were built in parallel before the classification\n";
+	if ( nDroppedCaches )
+		o << nDroppedCaches << " caches failed in the threads and were left to the classification\n";
+	if ( tBox.pCostProfile != NULL )
+		tBox.pCostProfile->print(o);
 
 	TaxonomyCreator::print(o);
 }
 
+void
+DLConceptTaxonomy :: getStatistic ( std::map<std::string, unsigned long>& values ) const
+{
+	values["nSubTests"] += nTries;
+	values["nSubTestsPositive"] += nPositives;
+	values["nSubCachedPositive"] += nCachedPositive;
+	values["nSubCachedNegative"] += nCachedNegative;
+	values["nSubSortedNegative"] += nSortedNegative;
+	values["nSubModuleNegative"] += nModuleNegative;
+	values["nSubELFPositive"] += nELFPositive;
+	values["nSubELFNegative"] += nELFNegative;
+	values["nSearchCalls"] += nSearchCalls;
+	values["nSubCalls"] += nSubCalls;
+}
+
 // Baader procedures
+void
+DLConceptTaxonomy :: prefetchSubsumptions ( TaxonomyVertex* cur )
+{
+	if ( pParallel == NULL || unlikely(inSplitCheck) )
+		return;
+
+	for ( TaxonomyVertex::iterator p = cur->begin(upDirection), p_end = cur->end(upDirection); p != p_end; ++p )
+	{
+		TaxonomyVertex* v = *p;
+		if ( isValued(v) )
+			continue;
+		// the same filters as in enhancedSubs2()
+		if ( upDirection && !v->isCommon() )
+			continue;
+		if ( useCandidates && candidates.find(v) == candidates.end() )
+			continue;
+
+		// the test would be made only if all the other neighbours are already known to be subsumers
+		bool sure = true;
+		for ( TaxonomyVertex::iterator q = v->begin(!upDirection), q_end = v->end(!upDirection); q != q_end && sure; ++q )
+			sure = isValued(*q) && getValue(*q);
+		if ( !sure )
+			continue;
+
+		const TConcept* testC = static_cast<const TConcept*>(v->getPrimer());
+		const TConcept* sub = upDirection ? testC : curConcept();
+		const TConcept* sup = upDirection ? curConcept() : testC;
+		if ( needTableauTest ( sub, sup ) && pParallel->canRunInParallel ( sub, sup ) )
+			pParallel->addTest ( sub, sup );
+	}
+
+	pParallel->runBatch();
+}
+
 void
 DLConceptTaxonomy :: searchBaader ( TaxonomyVertex* cur )
 {
@@ -158,6 +252,9 @@ DLConceptTaxonomy :: searchBaader ( TaxonomyVertex* cur )
 	++nSearchCalls;
 	bool noPosSucc = true;
 
+	// make all the necessary subsumption tests in parallel
+	prefetchSubsumptions(cur);
+
 	// check if there are positive successors; use DFS on them.
 	for ( TaxonomyVertex::iterator p = cur->begin(upDirection), p_end = cur->end(upDirection); p != p_end; ++p )
 		if ( enhancedSubs(*p) )
@@ -510,6 +607,44 @@ DLConceptTaxonomy :: reclassify ( TaxonomyVertex* node, const TSignature* s )
 |* 			Implementation of class TBox				*|
 \********************************************************/
 
+/// compare concepts wrt their costs known from the previous runs; the expensive ones go first
+class TKnownCostCompare
+{
+protected:	// members
+		/// profile with the known costs
+	const TCostProfile& Profile;
+
+public:		// interface
+		/// init c'tor
+	TKnownCostCompare ( const TCostProfile& profile ) : Profile(profile) {}
+		/// @return true iff P is known to be more expensive than Q
+	bool operator() ( const TConcept* p, const TConcept* q ) const
+		{ return Profile.getKnownCost(p->getName()) > Profile.getKnownCost(q->getName()); }
+}; // TKnownCostCompare
+
+/// compare concepts wrt the ABox components of the individuals; the concepts go first
+class TABoxComponentCompare
+{
+protected:	// members
+		/// partition of the ABox
+	const TABoxPartition& Partition;
+
+protected:	// methods
+		/// @return 0 for a concept, 1 + the index of the component for an individual
+	unsigned int getKey ( const TConcept* C ) const
+	{
+		if ( !C->isSingleton() )
+			return 0;
+		return Partition.getComponent(resolveSynonym(static_cast<const TIndividual*>(C))) + 1;
+	}
+
+public:		// interface
+		/// init c'tor
+	TABoxComponentCompare ( const TABoxPartition& partition ) : Partition(partition) {}
+		/// @return true iff P goes before Q
+	bool operator() ( const TConcept* p, const TConcept* q ) const { return getKey(p) < getKey(q); }
+}; // TABoxComponentCompare
+
 void TBox :: createTaxonomy ( bool needIndividual )
 {
 	bool needConcept = !needIndividual;
@@ -552,6 +687,26 @@ void TBox :: createTaxonomy ( bool needIndividual )
 //	if ( needIndividual || nNominalReferences > 0 )	// TODO ORE
 		nItems += fillArrays ( i_begin(), i_end() );
 
+	// start with the concepts that were expensive in the previous runs
+	if ( pCostProfile != NULL && !pCostProfile->noKnownCosts() )
+	{
+		TKnownCostCompare cmp(*pCostProfile);
+		std::stable_sort ( arrayCD.begin(), arrayCD.end(), cmp );
+		std::stable_sort ( arrayNoCD.begin(), arrayNoCD.end(), cmp );
+		std::stable_sort ( arrayNP.begin(), arrayNP.end(), cmp );
+	}
+
+	// realise the individuals component by component, so the nominal cloud is rarely changed
+	if ( pABoxPartition != NULL )
+	{
+		// the merges of the individuals are used before their first test
+		registerABoxComponents();
+		TABoxComponentCompare cmp(*pABoxPartition);
+		std::stable_sort ( arrayCD.begin(), arrayCD.end(), cmp );
+		std::stable_sort ( arrayNoCD.begin(), arrayNoCD.end(), cmp );
+		std::stable_sort ( arrayNP.begin(), arrayNP.end(), cmp );
+	}
+
 	// taxonomy progress
 	if ( pMonitor )
 	{
@@ -561,12 +716,41 @@ void TBox :: createTaxonomy ( bool needIndividual )
 
 	duringClassification = true;
 
-//	sort ( arrayCD.begin(), arrayCD.end(), TSDepthCompare() );
-	classifyConcepts ( arrayCD, true, "completely defined" );
-//	sort ( arrayNoCD.begin(), arrayNoCD.end(), TSDepthCompare() );
-	classifyConcepts ( arrayNoCD, false, "regular" );
-//	sort ( arrayNP.begin(), arrayNP.end(), TSDepthCompare() );
-	classifyConcepts ( arrayNP, false, "non-primitive" );
+	// run subsumption tests in parallel if required
+	ParallelSubTester* pParallel = NULL;
+	if ( nClassificationThreads > 1 )
+	{
+		pParallel = new ParallelSubTester ( *this, nClassificationThreads );
+		pTaxCreator->setParallelTester(pParallel);
+	}
+
+	try
+	{
+		// build the caches used by the classification in parallel; the serial tests would mostly hit them
+		if ( pParallel != NULL )
+		{
+			ParallelCacheBuilder Builder ( *this, nClassificationThreads );
+			Builder.addConcepts ( arrayCD.begin(), arrayCD.end() );
+			Builder.addConcepts ( arrayNoCD.begin(), arrayNoCD.end() );
+			Builder.addConcepts ( arrayNP.begin(), arrayNP.end() );
+			Builder.run();
+			pTaxCreator->addParallelCaches ( Builder.getNBuilt(), Builder.getNDropped() );
+		}
+//		sort ( arrayCD.begin(), arrayCD.end(), TSDepthCompare() );
+		classifyConcepts ( arrayCD, true, "completely defined" );
+//		sort ( arrayNoCD.begin(), arrayNoCD.end(), TSDepthCompare() );
+		classifyConcepts ( arrayNoCD, false, "regular" );
+//		sort ( arrayNP.begin(), arrayNP.end(), TSDepthCompare() );
+		classifyConcepts ( arrayNP, false, "non-primitive" );
+	}
+	catch(...)
+	{
+		// stop the worker threads before passing the exception through
+		pTaxCreator->setParallelTester(NULL);
+		delete pParallel;
+		duringClassification = false;
+		throw;
+	}
 
 	duringClassification = false;
 
@@ -594,6 +778,9 @@ void TBox :: createTaxonomy ( bool needIndividual )
 		std::ofstream of("Taxonomy.log");
 		pTaxCreator->print(of);
 	}
+
+	pTaxCreator->setParallelTester(NULL);
+	delete pParallel;
 }
 
 void
@@ -611,6 +798,7 @@ TBox :: classifyConcepts ( const ConceptVector& collection, bool curCompletelyDe
 		// check if concept is already classified
 		if ( !isCancelled() && !(*q)->isClassified () /*&& (*q)->isClassifiable(curCompletelyDefined)*/ )
 		{
+			checkInterrupt();
 			classifyEntry(*q);	// need to classify concept
 			if ( (*q)->isClassified() )
 				++n;
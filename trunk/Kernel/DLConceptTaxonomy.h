@@ -23,6 +23,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "dlTBox.h"
 #include "tProgressMonitor.h"
 #include "tSplitVars.h"
+#include "ParallelSubTester.h"
 
 /// Taxonomy of named DL concepts (and mapped individuals)
 class DLConceptTaxonomy: public TaxonomyCreator
@@ -95,9 +96,19 @@ protected:	// members
 	unsigned long nSortedNegative;
 		/// number of non-subsumptions because of module reasons
 	unsigned long nModuleNegative;
+		/// number of subsumptions found by the EL saturation
+	unsigned long nELFPositive;
+		/// number of non-subsumptions found by the EL saturation
+	unsigned long nELFNegative;
+		/// number of caches built in parallel before the classification
+	unsigned long nParallelCaches;
+		/// number of caches the workers failed to build before the classification
+	unsigned long nDroppedCaches;
 
 		/// indicator of taxonomy creation progress
 	TProgressMonitor* pTaxProgress;
+		/// tester that runs subsumption tests in parallel (if any)
+	ParallelSubTester* pParallel;
 
 	// flags
 
@@ -121,10 +132,15 @@ protected:	// methods
 	const TConcept* curConcept ( void ) const { return static_cast<const TConcept*>(curEntry); }
 		/// tests subsumption (via tBox) and gather statistics.  Use cache and other optimisations.
 	bool testSub ( const TConcept* p, const TConcept* q );
+		/// @return true iff the SUB(P,Q) test can't be answered without the tableau; doesn't gather statistics
+	bool needTableauTest ( const TConcept* p, const TConcept* q );
 		/// test subsumption via TBox explicitely
 	bool testSubTBox ( const TConcept* p, const TConcept* q )
 	{
-		bool res = tBox.isSubHolds ( p, q );
+		bool res;
+		// use the result of the parallel test if it is known
+		if ( pParallel == NULL || !pParallel->getResult ( p, q, res ) )
+			res = tBox.isSubHolds ( p, q );
 
 		// update statistic
 		++nTries;
@@ -139,6 +155,8 @@ protected:	// methods
 
 	// interface from BAADER paper
 
+		/// run in parallel all the tableau tests that will surely be made for the successors of CUR
+	void prefetchSubsumptions ( TaxonomyVertex* cur );
 		/// SEARCH procedure from Baader et al paper
 	void searchBaader ( TaxonomyVertex* cur );
 		/// ENHANCED_SUBS procedure from Baader et al paper
@@ -246,6 +264,8 @@ protected:	// methods
 		++nConcepts;
 		if ( pTaxProgress != NULL )
 			pTaxProgress->nextClass();
+		if ( pParallel != NULL )
+			pParallel->clear();
 	}
 		/// @return true iff curEntry is classified as a synonym
 	virtual bool classifySynonym ( void );
@@ -280,7 +300,12 @@ public:		// interface
 		, nCachedNegative(0)
 		, nSortedNegative(0)
 		, nModuleNegative(0)
+		, nELFPositive(0)
+		, nELFNegative(0)
+		, nParallelCaches(0)
+		, nDroppedCaches(0)
 		, pTaxProgress (NULL)
+		, pParallel(NULL)
 		, inSplitCheck(false)
 	{
 	}
@@ -299,6 +324,12 @@ public:		// interface
 	void reclassify ( const std::set<const TNamedEntity*>& MPlus, const std::set<const TNamedEntity*>& MMinus );
 		/// set progress indicator
 	void setProgressIndicator ( TProgressMonitor* pMon ) { pTaxProgress = pMon; }
+		/// set parallel subsumption tester
+	void setParallelTester ( ParallelSubTester* tester ) { pParallel = tester; }
+		/// add N to the number of caches built in parallel, NDROPPED to the number of the ones the workers failed to build
+	void addParallelCaches ( unsigned long n, unsigned long nDropped ) { nParallelCaches += n; nDroppedCaches += nDropped; }
+		/// add the values of the classification counters to VALUES; the values are indexed by the counter names
+	void getStatistic ( std::map<std::string, unsigned long>& values ) const;
 		/// output taxonomy to a stream
 	virtual void print ( std::ostream& o ) const;
 }; // DLConceptTaxonomy
@@ -311,7 +342,7 @@ inline bool DLConceptTaxonomy :: isUnsatisfiable ( void )
 {
 	const TConcept* p = curConcept();
 
-	if ( tBox.isSatisfiable(p) )
+	if ( tBox.isELFComplete(p) ? !tBox.isELFUnsatisfiable(p) : tBox.isSatisfiable(p) )
 		return false;
 
 	pTax->addCurrentToSynonym(pTax->getBottomVertex());
@@ -326,8 +357,9 @@ inline bool DLConceptTaxonomy :: immediatelyClassified ( void )
 	if ( curConcept()->getClassTag() == cttTrueCompletelyDefined )
 		return false;	// true CD concepts can not be unsat
 
-	// after SAT testing plan would be implemented
-	tBox.initCache(const_cast<TConcept*>(curConcept()));
+	// after SAT testing plan would be implemented; EL-complete concepts do not need the model
+	if ( !tBox.isELFComplete(curConcept()) )
+		tBox.initCache(const_cast<TConcept*>(curConcept()));
 
 	return isUnsatisfiable();
 }
@@ -355,6 +387,9 @@ TBox :: classifyEntry ( TConcept* entry )
 inline void
 TBox :: reclassify ( const std::set<const TNamedEntity*>& MPlus, const std::set<const TNamedEntity*>& MMinus )
 {
+	clearRelatedIndex();
+	setELFReasoner(NULL);	// the saturation is out of date
+	registerABoxComponents();	// the unchanged ABox components were not checked after the reload
 	pTaxCreator->reclassify ( MPlus, MMinus );
 	Status = kbRealised;	// FIXME!! check whether it is classified/realised
 }
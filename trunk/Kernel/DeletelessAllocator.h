@@ -19,26 +19,92 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef _DELETELESSALLOCATOR_H
 #define _DELETELESSALLOCATOR_H
 
-#include "growingArrayP.h"
+#include <vector>
+
+using std::size_t;
 
 /**
  * Class for the allocator that does not allowed 'delete'. Instead
- * it allows user to reuse all allocated memory.
+ * it allows user to reuse all allocated memory. Objects are created
+ * in chunks, so the objects allocated one after another are placed
+ * next to each other in memory.
  */
 template<class T>
-class DeletelessAllocator: public growingArrayP<T>
+class DeletelessAllocator
 {
-public:
+protected:	// typedefs
+		/// type for the array of objects
+	typedef std::vector<T*> baseType;
+
+protected:	// members
+		/// all the objects in the order of allocation
+	baseType Base;
+		/// chunks of memory that keep the objects
+	baseType Chunks;
+		/// index of the first object of every chunk in the Base
+	std::vector<size_t> ChunkStart;
+		/// index of the next unallocated entry
+	size_t last;
+
+private:	// prevent from copying
+		/// no copy c'tor
+	DeletelessAllocator ( const DeletelessAllocator& );
+		/// no assignment
+	DeletelessAllocator& operator= ( const DeletelessAllocator& );
+
+protected:	// methods
+		/// add a new chunk doubling the number of objects
+	void grow ( void )
+	{
+		size_t size = Base.size(), n = size ? size : 1;
+		T* chunk = new T[n];
+		Chunks.push_back(chunk);
+		ChunkStart.push_back(size);
+		Base.reserve(size+n);
+		for ( size_t i = 0; i < n; ++i )
+			Base.push_back(chunk+i);
+	}
+
+public:		// interface
 		/// c'tor: do nothing
-	DeletelessAllocator ( void ) {}
-		/// d'tor: do nothing (all done in ~gaP)
-	virtual ~DeletelessAllocator ( void ) {}
+	DeletelessAllocator ( void ) : last(0) {}
+		/// d'tor: delete all the chunks
+	virtual ~DeletelessAllocator ( void )
+	{
+		for ( typename baseType::iterator p = Chunks.begin(), p_end = Chunks.end(); p != p_end; ++p )
+			delete [] *p;
+	}
 
 		/// get a new object from the heap
 	T* get ( void )
 	{
-		this->ensureHeapSize();
-		return this->Base[this->last++];
+		if ( last >= Base.size() )
+			grow();
+		return Base[last++];
+	}
+		/// resize an array
+	void resize ( size_t n )
+	{
+		while ( n > Base.size() )
+			grow();
+		last = n;
+	}
+		/// get the number of elements
+	size_t size ( void ) const { return last; }
+		/// check if heap is empty
+	bool empty ( void ) const { return last == 0; }
+		/// mark all array elements as unused
+	void clear ( void ) { last = 0; }
+		/// free the unused chunks that hold objects beyond the first N ones
+	void shrink ( size_t n )
+	{
+		while ( !Chunks.empty() && ChunkStart.back() >= n && ChunkStart.back() >= last )
+		{
+			delete [] Chunks.back();
+			Base.resize(ChunkStart.back());
+			Chunks.pop_back();
+			ChunkStart.pop_back();
+		}
 	}
 }; // DeletelessAllocator
 
@@ -19,10 +19,16 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef DEPSET_H
 #define DEPSET_H
 
-#include "tDepSet.h"
+#include "globaldef.h"
 
 // define type for dependency set
+#ifdef RKG_USE_LIST_DEPSET
+#	include "tDepSet.h"
 typedef TDepSet DepSet;
+#else
+#	include "tBitDepSet.h"
+typedef TBitDepSet DepSet;
+#endif
 
 // common operations with the dep-set
 template <class O>
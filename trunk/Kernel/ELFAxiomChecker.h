@@ -0,0 +1,137 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef ELFAXIOMCHECKER_H
+#define ELFAXIOMCHECKER_H
+
+#include "tDLAxiom.h"
+#include "tOntology.h"
+
+/// check whether an expression belongs to the EL fragment supported by the ELFReasoner
+class ELFExpressionChecker: public DLExpressionVisitorEmpty
+{
+protected:	// members
+		/// keep the value here
+	bool isEL;
+
+public:		// interface
+		/// empty c'tor
+	ELFExpressionChecker ( void ) : isEL(false) {}
+		/// empty d'tor
+	virtual ~ELFExpressionChecker ( void ) {}
+
+		/// @return true iff an EXPRession is in the EL fragment
+	bool check ( const TDLExpression* expr )
+	{
+		isEL = false;
+		expr->accept(*this);
+		return isEL;
+	}
+
+public:		// visitor interface
+	// concept expressions
+	virtual void visit ( const TDLConceptTop& ) { isEL = true; }
+	virtual void visit ( const TDLConceptBottom& ) { isEL = true; }
+	virtual void visit ( const TDLConceptName& ) { isEL = true; }
+	virtual void visit ( const TDLConceptAnd& expr )
+	{
+		for ( TDLConceptAnd::iterator p = expr.begin(), p_end = expr.end(); p != p_end; ++p )
+			if ( !check(*p) )	// here isEL is false, so just return
+				return;
+		isEL = true;
+	}
+	virtual void visit ( const TDLConceptObjectExists& expr )
+	{
+		bool roleEL = check(expr.getOR());
+		isEL = roleEL && check(expr.getC());
+	}
+
+	// object role expressions: only the named roles are allowed
+	virtual void visit ( const TDLObjectRoleName& ) { isEL = true; }
+}; // ELFExpressionChecker
+
+/// check whether an axiom belongs to the EL fragment supported by the ELFReasoner
+class ELFAxiomChecker: public DLAxiomVisitorEmpty
+{
+protected:	// members
+		/// expression checker
+	ELFExpressionChecker Checker;
+		/// keep the value here
+	bool isEL;
+
+protected:	// methods
+		/// @return true iff all the arguments of an n-ary expression are EL ones
+	template<class Argument>
+	bool checkArgs ( const TDLNAryExpression<Argument>& expr )
+	{
+		for ( typename TDLNAryExpression<Argument>::iterator p = expr.begin(), p_end = expr.end(); p != p_end; ++p )
+			if ( !Checker.check(*p) )
+				return false;
+		return true;
+	}
+
+public:		// interface
+		/// empty c'tor
+	ELFAxiomChecker ( void ) : isEL(false) {}
+		/// empty d'tor
+	virtual ~ELFAxiomChecker ( void ) {}
+
+		/// @return true iff an AXiom is in the EL fragment
+	bool check ( const TDLAxiom* ax )
+	{
+		isEL = false;
+		ax->accept(*this);
+		return isEL;
+	}
+
+public:		// visitor interface
+	virtual void visit ( const TDLAxiomDeclaration& ) { isEL = true; }
+
+	virtual void visit ( const TDLAxiomEquivalentConcepts& axiom ) { isEL = checkArgs(axiom); }
+	virtual void visit ( const TDLAxiomDisjointConcepts& axiom ) { isEL = checkArgs(axiom); }
+	virtual void visit ( const TDLAxiomEquivalentORoles& axiom ) { isEL = checkArgs(axiom); }
+	// individual (in)equalities do not change the subsumption in the consistent ontology
+	virtual void visit ( const TDLAxiomSameIndividuals& ) { isEL = true; }
+	virtual void visit ( const TDLAxiomDifferentIndividuals& ) { isEL = true; }
+
+	virtual void visit ( const TDLAxiomORoleSubsumption& axiom )
+		{ isEL = Checker.check(axiom.getSubRole()) && Checker.check(axiom.getRole()); }
+	virtual void visit ( const TDLAxiomORoleDomain& axiom )
+		{ isEL = Checker.check(axiom.getRole()) && Checker.check(axiom.getDomain()); }
+	virtual void visit ( const TDLAxiomRoleTransitive& axiom ) { isEL = Checker.check(axiom.getRole()); }
+
+	virtual void visit ( const TDLAxiomConceptInclusion& axiom )
+		{ isEL = Checker.check(axiom.getSubC()) && Checker.check(axiom.getSupC()); }
+	// the assertions do not change the subsumption in the consistent ontology without nominals
+	virtual void visit ( const TDLAxiomInstanceOf& axiom ) { isEL = Checker.check(axiom.getC()); }
+	virtual void visit ( const TDLAxiomRelatedTo& axiom ) { isEL = Checker.check(axiom.getRelation()); }
+
+		/// check whether all the used axioms of the ontology are in the EL fragment
+	virtual void visitOntology ( TOntology& ontology )
+	{
+		bool allEL = true;
+		for ( TOntology::iterator p = ontology.begin(), p_end = ontology.end(); p != p_end; ++p )
+			if ( (*p)->isUsed() && !check(*p) )
+				allEL = false;
+		isEL = allEL;
+	}
+		/// get the result of the ontology check
+	bool getResult ( void ) const { return isEL; }
+}; // ELFAxiomChecker
+
+#endif
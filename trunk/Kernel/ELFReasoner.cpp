@@ -0,0 +1,527 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <algorithm>
+
+#include "ELFReasoner.h"
+#include "ELFAxiomChecker.h"
+#include "OntologyBasedModularizer.h"
+#include "fpp_assert.h"
+
+ELFReasoner :: ELFReasoner ( void )
+	: nFacts(0)
+	, nModules(0)
+{
+	Concepts.push_back(ELConcept(ckTop));
+	Concepts.push_back(ELConcept(ckBottom));
+}
+
+ELFReasoner :: ~ELFReasoner ( void )
+{
+	for ( std::vector<Context*>::iterator p = Contexts.begin(), p_end = Contexts.end(); p != p_end; ++p )
+		delete *p;
+}
+
+//-----------------------------------------------------------------
+//--	normalisation
+//-----------------------------------------------------------------
+
+unsigned int
+ELFReasoner :: getNameId ( const TNamedEntity* C )
+{
+	std::map<const TNamedEntity*, unsigned int>::iterator p = NameMap.find(C);
+	if ( p != NameMap.end() )
+		return p->second;
+	unsigned int id = Concepts.size();
+	Concepts.push_back(ELConcept(ckName));
+	NameMap[C] = id;
+	return id;
+}
+
+unsigned int
+ELFReasoner :: getRoleId ( const TDLObjectRoleComplexExpression* R )
+{
+	const TDLObjectRoleName* Name = dynamic_cast<const TDLObjectRoleName*>(R);
+	fpp_assert ( Name != NULL );	// checked by the ELFAxiomChecker
+	const TNamedEntity* entity = Name;
+	std::map<const TNamedEntity*, unsigned int>::iterator p = RoleMap.find(entity);
+	if ( p != RoleMap.end() )
+		return p->second;
+	unsigned int id = ToldSupRoles.size();
+	ToldSupRoles.push_back(IdVector());
+	Transitive.push_back(false);
+	RoleMap[entity] = id;
+	return id;
+}
+
+unsigned int
+ELFReasoner :: getAndId ( IdVector& args )
+{
+	// flatten the conjunction; remove TOPs
+	IdVector flat;
+	for ( IdVector::iterator p = args.begin(), p_end = args.end(); p != p_end; ++p )
+	{
+		if ( *p == BottomId )
+			return BottomId;
+		if ( *p == TopId )
+			continue;
+		if ( Concepts[*p].kind == ckAnd )
+			flat.insert ( flat.end(), Concepts[*p].args.begin(), Concepts[*p].args.end() );
+		else
+			flat.push_back(*p);
+	}
+	std::sort ( flat.begin(), flat.end() );
+	flat.erase ( std::unique ( flat.begin(), flat.end() ), flat.end() );
+
+	if ( flat.empty() )
+		return TopId;
+	if ( flat.size() == 1 )
+		return flat.front();
+
+	std::map<IdVector, unsigned int>::iterator p = AndMap.find(flat);
+	if ( p != AndMap.end() )
+		return p->second;
+	unsigned int id = Concepts.size();
+	Concepts.push_back(ELConcept(ckAnd));
+	Concepts.back().args = flat;
+	AndMap[flat] = id;
+	return id;
+}
+
+unsigned int
+ELFReasoner :: getExistsId ( unsigned int R, unsigned int C )
+{
+	// (R some BOTTOM) is BOTTOM
+	if ( C == BottomId )
+		return BottomId;
+	Link key(R,C);
+	std::map<Link, unsigned int>::iterator p = ExistsMap.find(key);
+	if ( p != ExistsMap.end() )
+		return p->second;
+	unsigned int id = Concepts.size();
+	Concepts.push_back(ELConcept(ckExists,R,C));
+	ExistsMap[key] = id;
+	return id;
+}
+
+unsigned int
+ELFReasoner :: translate ( const TDLConceptExpression* expr, bool pos )
+{
+	unsigned int id;
+
+	if ( dynamic_cast<const TDLConceptTop*>(expr) != NULL )
+		id = TopId;
+	else if ( dynamic_cast<const TDLConceptBottom*>(expr) != NULL )
+		id = BottomId;
+	else if ( const TDLConceptName* Name = dynamic_cast<const TDLConceptName*>(expr) )
+		id = getNameId(Name);
+	else if ( const TDLConceptAnd* And = dynamic_cast<const TDLConceptAnd*>(expr) )
+	{
+		IdVector args;
+		for ( TDLConceptAnd::iterator p = And->begin(), p_end = And->end(); p != p_end; ++p )
+			args.push_back(translate(*p,pos));
+		id = getAndId(args);
+	}
+	else
+	{
+		const TDLConceptObjectExists* Exists = dynamic_cast<const TDLConceptObjectExists*>(expr);
+		fpp_assert ( Exists != NULL );	// checked by the ELFAxiomChecker
+		unsigned int R = getRoleId(Exists->getOR());
+		id = getExistsId ( R, translate ( Exists->getC(), pos ) );
+	}
+
+	if ( pos )
+		markPositive(id);
+	else
+		markNegative(id);
+	return id;
+}
+
+void
+ELFReasoner :: markPositive ( unsigned int C )
+{
+	if ( Concepts[C].posOcc )
+		return;
+	Concepts[C].posOcc = true;
+	if ( Concepts[C].kind == ckAnd )
+		for ( IdVector::const_iterator p = Concepts[C].args.begin(), p_end = Concepts[C].args.end(); p != p_end; ++p )
+			markPositive(*p);
+	else if ( Concepts[C].kind == ckExists )
+		markPositive(Concepts[C].filler);
+}
+
+void
+ELFReasoner :: markNegative ( unsigned int C )
+{
+	if ( Concepts[C].negOcc )
+		return;
+	Concepts[C].negOcc = true;
+	if ( Concepts[C].kind == ckAnd )
+		for ( IdVector::const_iterator p = Concepts[C].args.begin(), p_end = Concepts[C].args.end(); p != p_end; ++p )
+		{
+			Concepts[*p].negAnds.push_back(C);
+			markNegative(*p);
+		}
+	else if ( Concepts[C].kind == ckExists )
+	{
+		Concepts[Concepts[C].filler].negExists.push_back(C);
+		markNegative(Concepts[C].filler);
+	}
+}
+
+void
+ELFReasoner :: prepareRoles ( void )
+{
+	unsigned int nRoles = ToldSupRoles.size();
+
+	// reflexive-transitive closure of the told role hierarchy
+	SubRole.assign ( nRoles, std::vector<bool>(nRoles,false) );
+	for ( unsigned int r = 0; r < nRoles; ++r )
+	{
+		IdVector stack(1,r);
+		SubRole[r][r] = true;
+		while ( !stack.empty() )
+		{
+			unsigned int s = stack.back();
+			stack.pop_back();
+			for ( IdVector::const_iterator p = ToldSupRoles[s].begin(), p_end = ToldSupRoles[s].end(); p != p_end; ++p )
+				if ( !SubRole[r][*p] )
+				{
+					SubRole[r][*p] = true;
+					stack.push_back(*p);
+				}
+		}
+	}
+
+	// (T some C) [= (R some C) for every transitive T [= R: makes the transitive chains visible for (R some C)
+	unsigned int nConcepts = Concepts.size();
+	for ( unsigned int c = 0; c < nConcepts; ++c )
+	{
+		if ( Concepts[c].kind != ckExists || !Concepts[c].negOcc )
+			continue;
+		unsigned int R = Concepts[c].role, F = Concepts[c].filler;
+		for ( unsigned int T = 0; T < nRoles; ++T )
+			if ( T != R && Transitive[T] && isSubRole(T,R) )
+			{
+				unsigned int E = getExistsId(T,F);
+				markNegative(E);
+				addRule(E,c);
+			}
+	}
+}
+
+//-----------------------------------------------------------------
+//--	saturation
+//-----------------------------------------------------------------
+
+ELFReasoner::Context*
+ELFReasoner :: getContext ( unsigned int C )
+{
+	if ( Contexts[C] == NULL )
+	{
+		Contexts[C] = new Context();
+		addFact ( C, C );
+		addFact ( C, TopId );
+	}
+	return Contexts[C];
+}
+
+void
+ELFReasoner :: processFact ( unsigned int X, unsigned int C )
+{
+	Context* ctx = Contexts[X];
+	// nothing to derive in the unsatisfiable context
+	if ( ctx->Subsumers.count(BottomId) > 0 )
+		return;
+	if ( !ctx->Subsumers.insert(C).second )
+		return;
+	++nFacts;
+
+	const ELConcept& Concept = Concepts[C];
+	std::vector<Link>::const_iterator q, q_end;
+
+	for ( IdVector::const_iterator p = Concept.told.begin(), p_end = Concept.told.end(); p != p_end; ++p )
+		addFact ( X, *p );
+
+	switch ( Concept.kind )
+	{
+	case ckBottom:	// all the predecessors are unsatisfiable
+		for ( q = ctx->Preds.begin(), q_end = ctx->Preds.end(); q != q_end; ++q )
+			addFact ( q->second, BottomId );
+		break;
+
+	case ckAnd:
+		for ( IdVector::const_iterator p = Concept.args.begin(), p_end = Concept.args.end(); p != p_end; ++p )
+			addFact ( X, *p );
+		break;
+
+	case ckExists:
+		if ( Concept.posOcc )
+			addLink ( X, Concept.role, Concept.filler );
+		// propagate (T some C) along the T-chain for the transitive T
+		if ( Concept.negOcc && Transitive[Concept.role] )
+			for ( q = ctx->Preds.begin(), q_end = ctx->Preds.end(); q != q_end; ++q )
+				if ( isSubRole ( q->first, Concept.role ) )
+					addFact ( q->second, C );
+		break;
+
+	default:
+		break;
+	}
+
+	// negatively occurred conjunctions
+	for ( IdVector::const_iterator p = Concept.negAnds.begin(), p_end = Concept.negAnds.end(); p != p_end; ++p )
+	{
+		const IdVector& args = Concepts[*p].args;
+		IdVector::const_iterator a = args.begin(), a_end = args.end();
+		while ( a != a_end && ctx->Subsumers.count(*a) > 0 )
+			++a;
+		if ( a == a_end )
+			addFact ( X, *p );
+	}
+
+	// negatively occurred existentials
+	for ( IdVector::const_iterator p = Concept.negExists.begin(), p_end = Concept.negExists.end(); p != p_end; ++p )
+		for ( q = ctx->Preds.begin(), q_end = ctx->Preds.end(); q != q_end; ++q )
+			if ( isSubRole ( q->first, Concepts[*p].role ) )
+				addFact ( q->second, *p );
+}
+
+void
+ELFReasoner :: addLink ( unsigned int X, unsigned int R, unsigned int C )
+{
+	Context* target = getContext(C);
+	if ( !Contexts[X]->Succs.insert(Link(R,C)).second )
+		return;
+	target->Preds.push_back(Link(R,X));
+
+	// apply the rules to the facts that are already in the target
+	for ( std::set<unsigned int>::const_iterator p = target->Subsumers.begin(), p_end = target->Subsumers.end(); p != p_end; ++p )
+	{
+		if ( *p == BottomId )
+			addFact ( X, BottomId );
+		const ELConcept& Concept = Concepts[*p];
+		for ( IdVector::const_iterator q = Concept.negExists.begin(), q_end = Concept.negExists.end(); q != q_end; ++q )
+			if ( isSubRole ( R, Concepts[*q].role ) )
+				addFact ( X, *q );
+		if ( Concept.kind == ckExists && Concept.negOcc && Transitive[Concept.role] && isSubRole ( R, Concept.role ) )
+			addFact ( X, *p );
+	}
+}
+
+const ELFReasoner::Context*
+ELFReasoner :: getNamedContext ( const TNamedEntity* C ) const
+{
+	if ( !isComplete(C) )
+		return NULL;
+	std::map<const TNamedEntity*, unsigned int>::const_iterator p = NameMap.find(C);
+	fpp_assert ( p != NameMap.end() && p->second < Contexts.size() );
+	return Contexts[p->second];
+}
+
+//-----------------------------------------------------------------
+//--	building the saturation
+//-----------------------------------------------------------------
+
+bool
+ELFReasoner :: loadOntology ( const TOntology& ontology )
+{
+	ELFAxiomChecker Checker;
+	const AxiomVec& Axioms = ontology.getAxioms();
+
+	for ( AxiomVec::const_iterator p = Axioms.begin(), p_end = Axioms.end(); p != p_end; ++p )
+	{
+		if ( !(*p)->isUsed() )
+			continue;
+		// gather all the concept names
+		const TSignature& sig = (*p)->getSignature();
+		for ( TSignature::iterator q = sig.begin(), q_end = sig.end(); q != q_end; ++q )
+			if ( dynamic_cast<const TDLConceptName*>(*q) != NULL )
+				AllNames.insert(*q);
+		if ( Checker.check(*p) )
+			(*p)->accept(*this);
+		else
+			NonEL.insert(*p);
+	}
+
+	return NonEL.empty();
+}
+
+void
+ELFReasoner :: findCompleteConcepts ( OntologyBasedModularizer& Mod )
+{
+	for ( std::set<const TNamedEntity*>::const_iterator p = AllNames.begin(), p_end = AllNames.end(); p != p_end; ++p )
+	{
+		if ( isComplete(*p) )	// known from a larger module
+			continue;
+
+		TSignature sig;
+		sig.add(*p);
+		const AxiomVec& Module = Mod.getModule ( sig, M_BOT );
+		++nModules;
+
+		AxiomVec::const_iterator q = Module.begin(), q_end = Module.end();
+		while ( q != q_end && NonEL.count(*q) == 0 )
+			++q;
+		if ( q != q_end )	// non-EL axiom in the module
+			continue;
+
+		// the modules of all the names in the signature of the module are sub-modules of it
+		const TSignature& ModSig = Mod.getModularizer()->getSignature();
+		for ( TSignature::iterator s = ModSig.begin(), s_end = ModSig.end(); s != s_end; ++s )
+			if ( AllNames.count(*s) > 0 )
+				Complete.insert(*s);
+	}
+}
+
+void
+ELFReasoner :: saturate ( void )
+{
+	prepareRoles();
+
+	// the complete names might not occur in EL axioms
+	IdVector Roots;
+	for ( std::set<const TNamedEntity*>::const_iterator p = Complete.begin(), p_end = Complete.end(); p != p_end; ++p )
+		Roots.push_back(getNameId(*p));
+
+	Contexts.resize ( Concepts.size(), NULL );
+	for ( IdVector::const_iterator p = Roots.begin(), p_end = Roots.end(); p != p_end; ++p )
+		getContext(*p);
+
+	while ( !ToDo.empty() )
+	{
+		Link fact = ToDo.front();
+		ToDo.pop();
+		processFact ( fact.first, fact.second );
+	}
+}
+
+//-----------------------------------------------------------------
+//--	queries
+//-----------------------------------------------------------------
+
+bool
+ELFReasoner :: isUnsatisfiable ( const TNamedEntity* C ) const
+{
+	const Context* ctx = getNamedContext(C);
+	fpp_assert ( ctx != NULL );
+	return ctx->Subsumers.count(BottomId) > 0;
+}
+
+bool
+ELFReasoner :: isSubsumedBy ( const TNamedEntity* C, const TNamedEntity* D ) const
+{
+	const Context* ctx = getNamedContext(C);
+	fpp_assert ( ctx != NULL );
+	if ( ctx->Subsumers.count(BottomId) > 0 )
+		return true;
+	std::map<const TNamedEntity*, unsigned int>::const_iterator p = NameMap.find(D);
+	if ( p == NameMap.end() )	// D doesn't appear in the EL axioms
+		return false;
+	return ctx->Subsumers.count(p->second) > 0;
+}
+
+void
+ELFReasoner :: printStatistics ( std::ostream& o ) const
+{
+	unsigned int nContexts = 0;
+	for ( std::vector<Context*>::const_iterator p = Contexts.begin(), p_end = Contexts.end(); p != p_end; ++p )
+		if ( *p != NULL )
+			++nContexts;
+
+	o << "\nEL saturation: " << Complete.size() << " of " << AllNames.size() << " concept names are complete ("
+	  << NonEL.size() << " non-EL axioms, " << nModules << " modules extracted); "
+	  << nContexts << " contexts with " << nFacts << " facts";
+}
+
+//-----------------------------------------------------------------
+//--	loading axioms
+//-----------------------------------------------------------------
+
+void
+ELFReasoner :: visit ( const TDLAxiomEquivalentConcepts& axiom )
+{
+	IdVector ids;
+	for ( TDLAxiomEquivalentConcepts::iterator p = axiom.begin(), p_end = axiom.end(); p != p_end; ++p )
+	{
+		unsigned int id = translate ( *p, /*pos=*/false );
+		markPositive(id);
+		ids.push_back(id);
+	}
+	// C1 [= C2 [= ... [= Cn [= C1
+	for ( size_t i = 0, n = ids.size(); i < n; ++i )
+		addRule ( ids[i], ids[(i+1)%n] );
+}
+
+void
+ELFReasoner :: visit ( const TDLAxiomDisjointConcepts& axiom )
+{
+	IdVector ids;
+	for ( TDLAxiomDisjointConcepts::iterator p = axiom.begin(), p_end = axiom.end(); p != p_end; ++p )
+		ids.push_back(translate ( *p, /*pos=*/false ));
+	// Ci and Cj [= BOTTOM
+	for ( size_t i = 0, n = ids.size(); i < n; ++i )
+		for ( size_t j = i+1; j < n; ++j )
+		{
+			IdVector args;
+			args.push_back(ids[i]);
+			args.push_back(ids[j]);
+			unsigned int And = getAndId(args);
+			markNegative(And);
+			addRule ( And, BottomId );
+		}
+}
+
+void
+ELFReasoner :: visit ( const TDLAxiomEquivalentORoles& axiom )
+{
+	IdVector ids;
+	for ( TDLAxiomEquivalentORoles::iterator p = axiom.begin(), p_end = axiom.end(); p != p_end; ++p )
+		ids.push_back(getRoleId(*p));
+	for ( size_t i = 0, n = ids.size(); i < n; ++i )
+		ToldSupRoles[ids[i]].push_back(ids[(i+1)%n]);
+}
+
+void
+ELFReasoner :: visit ( const TDLAxiomORoleSubsumption& axiom )
+{
+	unsigned int R = getRoleId(axiom.getSubRole());
+	unsigned int S = getRoleId(axiom.getRole());
+	ToldSupRoles[R].push_back(S);
+}
+
+void
+ELFReasoner :: visit ( const TDLAxiomORoleDomain& axiom )
+{
+	// (R some TOP) [= D
+	unsigned int E = getExistsId ( getRoleId(axiom.getRole()), TopId );
+	markNegative(E);
+	addRule ( E, translate ( axiom.getDomain(), /*pos=*/true ) );
+}
+
+void
+ELFReasoner :: visit ( const TDLAxiomRoleTransitive& axiom )
+{
+	Transitive[getRoleId(axiom.getRole())] = true;
+}
+
+void
+ELFReasoner :: visit ( const TDLAxiomConceptInclusion& axiom )
+{
+	addRule ( axiom.getSubC(), axiom.getSupC() );
+}
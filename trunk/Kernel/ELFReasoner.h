@@ -0,0 +1,229 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef ELFREASONER_H
+#define ELFREASONER_H
+
+#include <map>
+#include <set>
+#include <vector>
+#include <queue>
+#include <iostream>
+
+#include "tDLAxiom.h"
+
+class TOntology;
+class OntologyBasedModularizer;
+
+/**
+ *	Consequence-based (saturation) classifier for the EL fragment with
+ *	role hierarchy, transitive roles and role domains. Every concept
+ *	expression of the EL axioms is normalised to a numbered concept;
+ *	every concept that is a named one or a filler of an existential gets
+ *	a context. The completion rules derive all the subsumers of the context
+ *	roots in polynomial time.
+ *
+ *	The subsumers of a concept name are complete wrt the whole ontology iff
+ *	its \bot-module contains EL axioms only. Such concepts are marked as
+ *	complete; the rest of the concepts are classified by the tableau.
+ */
+class ELFReasoner: public DLAxiomVisitorEmpty
+{
+protected:	// types
+		/// vector of concept (or role) ids
+	typedef std::vector<unsigned int> IdVector;
+		/// (role,concept) link of a context to another context
+	typedef std::pair<unsigned int, unsigned int> Link;
+		/// kinds of the normalised concepts
+	enum ConceptKind { ckTop, ckBottom, ckName, ckAnd, ckExists };
+		/// ids of the TOP and BOTTOM concepts
+	enum { TopId = 0, BottomId = 1 };
+
+		/// normalised concept together with the rules it triggers
+	struct ELConcept
+	{
+			/// kind of the concept
+		ConceptKind kind;
+			/// role of an existential
+		unsigned int role;
+			/// filler of an existential
+		unsigned int filler;
+			/// sorted conjuncts of a conjunction
+		IdVector args;
+			/// concepts implied by this one
+		IdVector told;
+			/// negatively occurred conjunctions with this concept as a conjunct
+		IdVector negAnds;
+			/// negatively occurred existentials with this concept as a filler
+		IdVector negExists;
+			/// true iff the concept occurs positively (on the RHS)
+		bool posOcc;
+			/// true iff the concept occurs negatively (on the LHS)
+		bool negOcc;
+
+			/// init c'tor
+		ELConcept ( ConceptKind k, unsigned int R = 0, unsigned int F = 0 )
+			: kind(k)
+			, role(R)
+			, filler(F)
+			, posOcc(false)
+			, negOcc(false)
+			{}
+	}; // ELConcept
+
+		/// context: all the derived subsumers of a root concept
+	struct Context
+	{
+			/// derived subsumers
+		std::set<unsigned int> Subsumers;
+			/// (role,context) links to the predecessors
+		std::vector<Link> Preds;
+			/// (role,context) links to the successors
+		std::set<Link> Succs;
+	}; // Context
+
+protected:	// members
+		/// all the normalised concepts
+	std::vector<ELConcept> Concepts;
+		/// contexts indexed by the root concept id
+	std::vector<Context*> Contexts;
+		/// ids of the concept names
+	std::map<const TNamedEntity*, unsigned int> NameMap;
+		/// ids of the conjunctions
+	std::map<IdVector, unsigned int> AndMap;
+		/// ids of the existentials
+	std::map<Link, unsigned int> ExistsMap;
+		/// ids of the role names
+	std::map<const TNamedEntity*, unsigned int> RoleMap;
+		/// told super-roles of every role
+	std::vector<IdVector> ToldSupRoles;
+		/// reflexive-transitive closure of the role hierarchy: SubRole[s][r] iff s [= r
+	std::vector<std::vector<bool> > SubRole;
+		/// transitivity of the roles
+	std::vector<bool> Transitive;
+		/// all the concept names of the ontology
+	std::set<const TNamedEntity*> AllNames;
+		/// concept names whose subsumers are complete wrt the ontology
+	std::set<const TNamedEntity*> Complete;
+		/// axioms that are not in the EL fragment
+	std::set<const TDLAxiom*> NonEL;
+		/// queue of the (context,concept) facts to process
+	std::queue<Link> ToDo;
+
+		/// number of processed facts
+	unsigned long nFacts;
+		/// number of the modules extracted
+	unsigned long nModules;
+
+private:	// no copy
+		/// no copy c'tor
+	ELFReasoner ( const ELFReasoner& );
+		/// no assignment
+	ELFReasoner& operator = ( const ELFReasoner& );
+
+protected:	// methods
+	//-----------------------------------------------------------------
+	//--	normalisation
+	//-----------------------------------------------------------------
+
+		/// @return id of the concept name C
+	unsigned int getNameId ( const TNamedEntity* C );
+		/// @return id of the role name R
+	unsigned int getRoleId ( const TDLObjectRoleComplexExpression* R );
+		/// @return id of the conjunction of ARGS; ARGS are sorted
+	unsigned int getAndId ( IdVector& args );
+		/// @return id of the existential restriction (R some C)
+	unsigned int getExistsId ( unsigned int R, unsigned int C );
+		/// @return id of the concept expression EXPR that occurs with polarity POS
+	unsigned int translate ( const TDLConceptExpression* expr, bool pos );
+		/// mark concept C and its sub-concepts as positively occurred
+	void markPositive ( unsigned int C );
+		/// mark concept C and its sub-concepts as negatively occurred
+	void markNegative ( unsigned int C );
+		/// add rule C [= D
+	void addRule ( unsigned int C, unsigned int D ) { Concepts[C].told.push_back(D); }
+		/// add rule C [= D for the expressions C and D
+	void addRule ( const TDLConceptExpression* C, const TDLConceptExpression* D )
+		{ addRule ( translate ( C, /*pos=*/false ), translate ( D, /*pos=*/true ) ); }
+		/// build the role closure and the rules for the transitive sub-roles
+	void prepareRoles ( void );
+
+	//-----------------------------------------------------------------
+	//--	saturation
+	//-----------------------------------------------------------------
+
+		/// @return true iff role S is a sub-role of R
+	bool isSubRole ( unsigned int S, unsigned int R ) const { return SubRole[S][R]; }
+		/// @return context for the concept C; create it if necessary
+	Context* getContext ( unsigned int C );
+		/// add fact C to a context X
+	void addFact ( unsigned int X, unsigned int C ) { ToDo.push(Link(X,C)); }
+		/// process fact C in a context X
+	void processFact ( unsigned int X, unsigned int C );
+		/// add link from context X to the context of C via role R
+	void addLink ( unsigned int X, unsigned int R, unsigned int C );
+		/// @return context of the concept name C; NULL if C is not complete
+	const Context* getNamedContext ( const TNamedEntity* C ) const;
+
+public:		// interface
+		/// empty c'tor
+	ELFReasoner ( void );
+		/// d'tor
+	virtual ~ELFReasoner ( void );
+
+	//-----------------------------------------------------------------
+	//--	building the saturation
+	//-----------------------------------------------------------------
+
+		/// load all the EL axioms from the ONTOLOGY; @return true iff all the used axioms are in the EL fragment
+	bool loadOntology ( const TOntology& ontology );
+		/// mark all the concept names of the ontology as complete
+	void setAllComplete ( void ) { Complete = AllNames; }
+		/// mark as complete all the concept names whose \bot-modules contain EL axioms only
+	void findCompleteConcepts ( OntologyBasedModularizer& Mod );
+		/// @return true iff there is no complete concept names
+	bool noCompleteConcepts ( void ) const { return Complete.empty(); }
+		/// saturate contexts of all the complete concept names
+	void saturate ( void );
+
+	//-----------------------------------------------------------------
+	//--	queries
+	//-----------------------------------------------------------------
+
+		/// @return true iff all the subsumers of the concept name C are known
+	bool isComplete ( const TNamedEntity* C ) const { return Complete.count(C) > 0; }
+		/// @return true iff the complete concept name C is unsatisfiable
+	bool isUnsatisfiable ( const TNamedEntity* C ) const;
+		/// @return true iff the complete concept name C is subsumed by the concept name D
+	bool isSubsumedBy ( const TNamedEntity* C, const TNamedEntity* D ) const;
+		/// print the statistics of the saturation
+	void printStatistics ( std::ostream& o ) const;
+
+public:		// visitor interface
+	virtual void visit ( const TDLAxiomEquivalentConcepts& axiom );
+	virtual void visit ( const TDLAxiomDisjointConcepts& axiom );
+	virtual void visit ( const TDLAxiomEquivalentORoles& axiom );
+	virtual void visit ( const TDLAxiomORoleSubsumption& axiom );
+	virtual void visit ( const TDLAxiomORoleDomain& axiom );
+	virtual void visit ( const TDLAxiomRoleTransitive& axiom );
+	virtual void visit ( const TDLAxiomConceptInclusion& axiom );
+
+	virtual void visitOntology ( TOntology& ontology ) { loadOntology(ontology); }
+}; // ELFReasoner
+
+#endif
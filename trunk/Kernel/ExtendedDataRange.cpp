@@ -81,6 +81,8 @@ ReasoningKernel :: getDataRelatedIndividuals ( TDRoleExpr* R, TDRoleExpr* S, int
 	for ( IndVec::iterator q = Individuals.begin(), q_end = Individuals.end(); q != q_end; ++q )
 	{
 		const TIndividual* ind = getIndividual ( *q, "individual name expected in getDataRelatedIndividuals()" );
+		// the node of the individual is in the nominal cloud of its ABox component
+		getTBox()->prepareNominalCloud ( ind, NULL );
 		const DlCompletionTree* vR = NULL;
 		const DlCompletionTree* vS = NULL;
 		for ( DlCompletionTree::const_edge_iterator p = ind->node->begin(), p_end = ind->node->end(); p != p_end; ++p )
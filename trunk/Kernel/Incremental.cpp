@@ -28,6 +28,21 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 TsProcTimer moduleTimer, subCheckTimer;
 int nModule = 0;
 
+/// add the individuals of the assertion AX to CHANGED; @return false if AX is not an assertion
+static bool
+addChangedIndividuals ( TDLAxiom* ax, std::set<const TNamedEntity*>& Changed )
+{
+	// declarations do not change the models
+	if ( dynamic_cast<TDLAxiomIndividual*>(ax) == NULL && dynamic_cast<TDLAxiomSameIndividuals*>(ax) == NULL &&
+		 dynamic_cast<TDLAxiomDifferentIndividuals*>(ax) == NULL && dynamic_cast<TDLAxiomDeclaration*>(ax) == NULL )
+		return false;
+	const TSignature& sig = ax->getSignature();
+	for ( TSignature::iterator p = sig.begin(), p_end = sig.end(); p != p_end; ++p )
+		if ( dynamic_cast<const TDLIndividualName*>(*p) != NULL )
+			Changed.insert(*p);
+	return true;
+}
+
 /// setup Name2Sig for a given name C
 void
 ReasoningKernel :: setupSig ( const TNamedEntity* entity, const AxiomVec& Module )
@@ -43,7 +58,10 @@ ReasoningKernel :: setupSig ( const TNamedEntity* entity, const AxiomVec& Module
 	if ( insert == Name2Sig.end() )
 		insert = Name2Sig.insert(std::make_pair(entity,&sig)).first;
 	else
+	{
+		indexSig ( entity, *insert->second, /*add=*/false );
 		delete insert->second;
+	}
 
 	// calculate a module
 	sig.add(entity);
@@ -52,10 +70,42 @@ ReasoningKernel :: setupSig ( const TNamedEntity* entity, const AxiomVec& Module
 
 	// perform update
 	insert->second = new TSignature(getModExtractor(false)->getModularizer()->getSignature());
+	indexSig ( entity, *insert->second, /*add=*/true );
 
 	moduleTimer.Stop();
 }
 
+/// add (if ADD is true) or remove ENTITY as a name for every element of SIG in the Sig2Names
+void
+ReasoningKernel :: indexSig ( const TNamedEntity* entity, const TSignature& sig, bool add )
+{
+	for ( TSignature::iterator p = sig.begin(), p_end = sig.end(); p != p_end; ++p )
+		if ( add )
+			Sig2Names[*p].insert(entity);
+		else
+			Sig2Names[*p].erase(entity);
+}
+
+/// add the names whose module signatures might make AX non-local to CANDIDATES; @return true iff all names are candidates
+bool
+ReasoningKernel :: addLocalityCandidates ( TDLAxiom* ax, LocalityChecker* lc, NameSet& Candidates )
+{
+	// the locality of AX depends only on the part of a signature that AX shares;
+	// so AX is local wrt any signature disjoint with its one iff it is local wrt the empty one
+	TSignature emptySig;
+	lc->setSignatureValue(emptySig);
+	if ( !lc->local(ax) )
+		return true;
+	// here AX could be non-local only wrt the module signatures that contain some of its entities
+	for ( TSignature::iterator p = ax->getSignature().begin(), p_end = ax->getSignature().end(); p != p_end; ++p )
+	{
+		SigNameMap::const_iterator names = Sig2Names.find(*p);
+		if ( names != Sig2Names.end() )
+			Candidates.insert ( names->second.begin(), names->second.end() );
+	}
+	return false;
+}
+
 /// build signature for ENTITY and all dependent entities from toProcess; look for modules in Module;
 void
 ReasoningKernel :: buildSignature ( const TNamedEntity* entity, const AxiomVec& Module, std::set<const TNamedEntity*>& toProcess )
@@ -80,6 +130,7 @@ ReasoningKernel :: initIncremental ( void )
 	ModSyn = NULL;
 	// fill the module signatures of the concepts
 	Name2Sig.clear();
+	Sig2Names.clear();
 	// found all entities
 	std::set<const TNamedEntity*> toProcess;
 	for ( TBox::c_const_iterator p = getTBox()->c_begin(), p_end = getTBox()->c_end(); p != p_end; ++p )
@@ -101,6 +152,8 @@ ReasoningKernel :: doIncremental ( void )
 	TsProcTimer total;
 	total.Start();
 	std::cout << "Incremental!\n";
+	// the taxonomy is about to change, so the cached query results are invalid
+	QueryCache.clear();
 	// re-set the modularizer to use updated ontology
 	delete ModSyn;
 	ModSyn = NULL;
@@ -127,8 +180,13 @@ ReasoningKernel :: doIncremental ( void )
 			// remove all links
 			C->getTaxVertex()->remove();
 			// update Name2Sig
-			delete Name2Sig[*e];
-			Name2Sig.erase(*e);
+			NameSigMap::iterator sig = Name2Sig.find(*e);
+			if ( sig != Name2Sig.end() )
+			{
+				indexSig ( *e, *sig->second, /*add=*/false );
+				delete sig->second;
+				Name2Sig.erase(sig);
+			}
 		}
 
 	// deal with added concepts
@@ -167,37 +225,59 @@ ReasoningKernel :: doIncremental ( void )
 //		std::cout << "Del:";
 //		(*p)->accept(pr);
 //	}
-	for ( NameSigMap::iterator p = Name2Sig.begin(), p_end = Name2Sig.end(); p != p_end; ++p )
+	// filter the names by the signatures of the changed axioms first; only the candidates are checked for locality
+	NameSet PlusCandidates, MinusCandidates;
+	bool allPlus = false, allMinus = false;
+	for ( p = nb; p != ne; ++p )
+		if ( addLocalityCandidates ( *p, lc, PlusCandidates ) )
+			allPlus = true;
+	for ( p = rb; p != re; ++p )
+		if ( addLocalityCandidates ( *p, lc, MinusCandidates ) )
+			allMinus = true;
+	NameSet Candidates ( PlusCandidates );
+	Candidates.insert ( MinusCandidates.begin(), MinusCandidates.end() );
+	if ( allPlus || allMinus )
+		for ( NameSigMap::iterator q = Name2Sig.begin(), q_end = Name2Sig.end(); q != q_end; ++q )
+			Candidates.insert(q->first);
+
+	for ( NameSet::iterator c = Candidates.begin(), c_end = Candidates.end(); c != c_end; ++c )
 	{
-		lc->setSignatureValue(*p->second);
-		for ( TOntology::iterator notProcessed = nb; notProcessed != ne; ++notProcessed )
-			if ( !lc->local(*notProcessed) )
-			{
-				MPlus.insert(p->first);
-//				std::cout << "Non-local NP axiom ";
-//				(*notProcessed)->accept(pr);
-//				std::cout << " wrt " << p->first->getName() << std::endl;
-				break;
-			}
-		for ( TOntology::iterator retracted = rb; retracted != re; retracted++ )
-			if ( !lc->local(*retracted) )
-			{
-				MMinus.insert(p->first);
-				// FIXME!! only concepts for now
-				TaxonomyVertex* v = dynamic_cast<const ClassifiableEntry*>(p->first->getEntry())->getTaxVertex();
-				if ( v->noNeighbours(true) )
+		NameSigMap::iterator q = Name2Sig.find(*c);
+		if ( q == Name2Sig.end() )
+			continue;
+		lc->setSignatureValue(*q->second);
+		if ( allPlus || PlusCandidates.count(*c) > 0 )
+			for ( TOntology::iterator notProcessed = nb; notProcessed != ne; ++notProcessed )
+				if ( !lc->local(*notProcessed) )
 				{
-					v->addNeighbour(true,tax->getTopVertex());
-					tax->getTopVertex()->addNeighbour(false,v);
+					MPlus.insert(q->first);
+//					std::cout << "Non-local NP axiom ";
+//					(*notProcessed)->accept(pr);
+//					std::cout << " wrt " << q->first->getName() << std::endl;
+					break;
+				}
+		if ( allMinus || MinusCandidates.count(*c) > 0 )
+			for ( TOntology::iterator retracted = rb; retracted != re; retracted++ )
+				if ( !lc->local(*retracted) )
+				{
+					MMinus.insert(q->first);
+					// FIXME!! only concepts for now
+					TaxonomyVertex* v = dynamic_cast<const ClassifiableEntry*>(q->first->getEntry())->getTaxVertex();
+					if ( v->noNeighbours(true) )
+					{
+						v->addNeighbour(true,tax->getTopVertex());
+						tax->getTopVertex()->addNeighbour(false,v);
+					}
+//					std::cout << "Non-local RT axiom ";
+//					(*retracted)->accept(pr);
+//					std::cout << " wrt " << q->first->getName() << std::endl;
+					break;
 				}
-//				std::cout << "Non-local RT axiom ";
-//				(*retracted)->accept(pr);
-//				std::cout << " wrt " << p->first->getName() << std::endl;
-				break;
-			}
 	}
 	t.Stop();
-	std::cout << "Determine concepts that need reclassification: done in " << t << std::endl;
+	std::cout << "Determine concepts that need reclassification: done in " << t << " ("
+			  << ( Candidates.size() < Name2Sig.size() ? Name2Sig.size() - Candidates.size() : 0 )
+			  << " of " << Name2Sig.size() << " names pruned by the signature index)" << std::endl;
 
 	// build changed modules
 	std::set<const TNamedEntity*> toProcess(MPlus);
@@ -219,11 +299,22 @@ ReasoningKernel :: doIncremental ( void )
 	excluded.clear();
 	getTBox()->SaveTaxonomy(SLManager,excluded);
 
+	// if only the assertions were changed, only the ABox components with the changed individuals are re-checked
+	std::set<const TNamedEntity*> ChangedIndividuals;
+	bool onlyAssertions = true;
+	for ( p = nb; p != ne && onlyAssertions; ++p )
+		onlyAssertions = addChangedIndividuals ( *p, ChangedIndividuals );
+	for ( p = rb; p != re && onlyAssertions; ++p )
+		onlyAssertions = addChangedIndividuals ( *p, ChangedIndividuals );
+
 	// do actual change
 	useIncrementalReasoning = false;
 	forceReload();
 	pTBox->setNameSigMap(&Name2Sig);
+	if ( onlyAssertions )
+		pTBox->setChangedIndividuals(&ChangedIndividuals);
 	pTBox->isConsistent();
+	pTBox->setChangedIndividuals(NULL);
 	useIncrementalReasoning = true;
 
 	// load the taxonomy
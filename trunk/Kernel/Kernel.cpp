@@ -22,6 +22,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "AxiomSplitter.h"
 #include "AtomicDecomposer.h"
 #include "OntologyBasedModularizer.h"
+#include "ELFReasoner.h"
 #include "eFPPSaveLoad.h"
 #include "SaveLoadManager.h"
 
@@ -179,7 +180,15 @@ ReasoningKernel :: ClassifyOrLoad ( bool needIndividuals )
 			}
 		}
 	}
+	// record the costs of the tests to use them in the next runs
+	if ( pSLManager != NULL )
+	{
+		CostProfile.load(pSLManager->getCostProfileName());
+		pTBox->setCostProfile(&CostProfile);
+	}
+
 	// perform the real classification
+	initELFReasoner();
 	if ( needIndividuals )
 		pTBox->performRealisation();
 	else
@@ -187,7 +196,35 @@ ReasoningKernel :: ClassifyOrLoad ( bool needIndividuals )
 
 	// save the result if necessary
 	if ( pSLManager != NULL )
+	{
+		pTBox->setCostProfile(NULL);
+		CostProfile.update();
+		CostProfile.save(pSLManager->getCostProfileName());
 		Save();
+	}
+}
+
+void
+ReasoningKernel :: initELFReasoner ( void )
+{
+	// incremental reasoning changes the ontology under the saturation
+	if ( useIncrementalReasoning || !pTBox->needELFReasoner() )
+		return;
+
+	ELFReasoner* Reasoner = new ELFReasoner();
+	if ( Reasoner->loadOntology(Ontology) )	// pure EL ontology
+		Reasoner->setAllComplete();
+	else
+		Reasoner->findCompleteConcepts(*getModExtractor(/*useSemantic=*/false));
+
+	if ( Reasoner->noCompleteConcepts() )
+	{
+		delete Reasoner;
+		return;
+	}
+
+	Reasoner->saturate();
+	pTBox->setELFReasoner(Reasoner);
 }
 
 void
@@ -208,23 +245,33 @@ ReasoningKernel :: processKB ( KBStatus status )
 		return;
 	}
 
+	// the rest is a single operation wrt timeout and cancellation
+	TOperationGuard guard(&Operations);
+
 	// here curStatus < kbRealised, and status >= kbChecked
 	if ( curStatus == kbEmpty || curStatus == kbLoading )
 	{	// load and preprocess KB -- here might be failures
 		reasoningFailed = true;
 
-		// load the axioms from the ontology to the TBox
-		if ( needForceReload() )
-			forceReload();
-		else	// just do incremental classification and exit
+		try
 		{
-			doIncremental();
-			reasoningFailed = false;
-			return;
-		}
+			// load the axioms from the ontology to the TBox
+			if ( needForceReload() )
+				forceReload();
+			else	// just do incremental classification and exit
+			{
+				doIncremental();
+				reasoningFailed = false;
+				return;
+			}
 
-		// do the preprocessing and consistency check
-		pTBox->isConsistent();
+			// do the preprocessing and consistency check
+			pTBox->isConsistent();
+		}
+		catch ( const EFPPTimeout& )
+			{ dropInterruptedTBox(); throw; }
+		catch ( const EFPPCancelled& )
+			{ dropInterruptedTBox(); throw; }
 
 		// if there were no exception thrown -- clear the failure status
 		reasoningFailed = false;
@@ -281,16 +328,22 @@ ReasoningKernel :: setUpCache ( DLTree* query, cacheStatus level )
 			if ( cacheLevel == csSat )	// already check satisfiability
 			{
 				classifyQuery(isCN(cachedQueryTree));
+				cacheLevel = csClassified;
 				return;
 			}
 		}
 	}
 	else	// change current query
+	{
 		setQueryCache(query);
+		// the DAG entries of the previous query are not needed anymore; this keeps DAG size
+		// bounded even if the queries are about fresh names, which do not create a query concept
+		getTBox()->clearQueryConcept();
+	}
 
-	// clean cached info
+	// clean cached info; the query is classified at the end, so if it is interrupted, it should be classified again
 	cachedVertex = NULL;
-	cacheLevel = level;
+	cacheLevel = level == csClassified ? csSat : level;
 
 	// check if concept-to-cache is defined in ontology
 	if ( isCN(cachedQueryTree) )
@@ -304,7 +357,10 @@ ReasoningKernel :: setUpCache ( DLTree* query, cacheStatus level )
 		getTBox()->preprocessQueryConcept(cachedConcept);
 
 	if ( level == csClassified )
+	{
 		classifyQuery(isCN(cachedQueryTree));
+		cacheLevel = csClassified;
+	}
 }
 
 void
@@ -325,16 +381,22 @@ ReasoningKernel :: setUpCache ( TConceptExpr* query, cacheStatus level )
 			if ( cacheLevel == csSat )	// already check satisfiability
 			{
 				classifyQuery(isNameOrConst(cachedQuery));
+				cacheLevel = csClassified;
 				return;
 			}
 		}
 	}
 	else	// change current query
+	{
 		setQueryCache(query);
+		// the DAG entries of the previous query are not needed anymore; this keeps DAG size
+		// bounded even if the queries are about fresh names, which do not create a query concept
+		getTBox()->clearQueryConcept();
+	}
 
-	// clean cached info
+	// clean cached info; the query is classified at the end, so if it is interrupted, it should be classified again
 	cachedVertex = NULL;
-	cacheLevel = level;
+	cacheLevel = level == csClassified ? csSat : level;
 
 	// check if concept-to-cache is defined in ontology
 	if ( isNameOrConst(cachedQuery) )
@@ -348,7 +410,10 @@ ReasoningKernel :: setUpCache ( TConceptExpr* query, cacheStatus level )
 		getTBox()->preprocessQueryConcept(cachedConcept);
 
 	if ( level == csClassified )
+	{
 		classifyQuery(isNameOrConst(cachedQuery));
+		cacheLevel = csClassified;
+	}
 }
 
 //-------------------------------------------------
@@ -398,7 +463,7 @@ ReasoningKernel :: checkSub ( TConcept* C, TConcept* D )
 	SupConceptActor actor(D);
 	Taxonomy* tax = getCTaxonomy();
 	try { tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/true> ( C->getTaxVertex(), actor ); return false; }
-	catch (...) { tax->clearVisited(); return true; }
+	catch (...) { return true; }
 }
 
 //-------------------------------------------------
@@ -408,6 +473,7 @@ ReasoningKernel :: checkSub ( TConcept* C, TConcept* D )
 bool
 ReasoningKernel :: isDisjointRoles ( void )
 {
+	TOperationGuard guard(&Operations);
 	// grab all roles from the arg-list
 	typedef const std::vector<const TDLExpression*> TExprVec;
 	typedef std::vector<const TRole*> TRoleVec;
@@ -518,6 +584,15 @@ ReasoningKernel :: buildRelatedCache ( TIndividual* I, const TRole* R )
 	if ( R->isBottom() )
 		return CIVec();
 
+	// use the role assertion index if it contains all the fillers
+	const TRelatedIndex* index = getTBox()->getRelatedIndex();
+	if ( index->isComplete() && !R->isTop() )
+	{
+		CIVec ret;
+		index->getFillers ( I, R, ret );
+		return ret;
+	}
+
 	// now fills the query
 	RIActor actor;
 	// ask for instances of \exists R^-.{i}
@@ -539,11 +614,13 @@ ReasoningKernel :: getRelatedRoles ( const TIndividualExpr* I, NamesVector& Rs,
 	Rs.clear();
 
 	TIndividual* i = getIndividual ( I, "individual name expected in the getRelatedRoles()" );
+	const TRelatedIndex* index = getTBox()->getRelatedIndex();
 	RoleMaster* RM = data ? getDRM() : getORM();
 	for ( RoleMaster::iterator p = RM->begin(), p_end = RM->end(); p < p_end; ++p )
 	{
 		const TRole* R = *p;
-		if ( ( R->getId() > 0 || needI ) && !getRelated(i,R).empty() )
+		// explicitly related individuals do not require reasoning
+		if ( ( R->getId() > 0 || needI ) && ( index->hasFillers(i,R) || !getRelated(i,R).empty() ) )
 			Rs.push_back(R);
 	}
 }
@@ -558,6 +635,21 @@ ReasoningKernel :: getRoleFillers ( const TIndividualExpr* I, const TORoleExpr*
 		Result.push_back(const_cast<TIndividual*>(*p));
 }
 
+/// set RESULT into the set of all instances of given [complex] C; the KB is not realised for that
+void
+ReasoningKernel :: retrieveInstances ( const TConceptExpr* C, IndividualSet& Result )
+{
+	TOperationGuard guard(&Operations);
+	preprocessKB();	// the consistency check makes the caches of the individuals
+	Result.clear();
+	TMutexLock lock(QueryLock);
+	setUpCache ( C, csSat );
+	CIVec vec;
+	getTBox()->retrieveInstances ( cachedConcept, vec );
+	for ( CIVec::iterator p = vec.begin(), p_end = vec.end(); p < p_end; ++p )
+		Result.push_back(*p);
+}
+
 /// set RESULT into set of J's such that R(I,J)
 bool
 ReasoningKernel :: isRelated ( const TIndividualExpr* I, const TORoleExpr* R, const TIndividualExpr* J )
@@ -569,6 +661,9 @@ ReasoningKernel :: isRelated ( const TIndividualExpr* I, const TORoleExpr* R, co
 		return false;	// FIXME!! not implemented
 
 	TIndividual* j = getIndividual ( J, "Individual name expected in the isRelated()" );
+	// explicitly related individuals do not require reasoning
+	if ( getTBox()->getRelatedIndex()->isRelated ( i, r, j ) )
+		return true;
 	CIVec vec = getRelated ( i, r );
 	for ( CIVec::iterator p = vec.begin(), p_end = vec.end(); p < p_end; ++p )
 		if ( j == (*p) )
@@ -590,6 +685,12 @@ ReasoningKernel :: getAtomicDecompositionSize ( bool useSemantic, ModuleType mod
 		delete AD;
 
 	AD = new AtomicDecomposer(getModExtractor(useSemantic)->getModularizer());
+	// semantic locality checkers use their own reasoners, so they are run in the main thread only
+	if ( !useSemantic )
+	{
+		int nThreads = KernelOptions.getInt("decompositionThreads");
+		AD->setNThreads ( nThreads > 1 ? static_cast<unsigned int>(nThreads) : 1 );
+	}
 	return AD->getAOS ( &Ontology, moduleType )->size();
 }
 	/// get a set of axioms that corresponds to the atom with the id INDEX
@@ -756,6 +857,16 @@ bool ReasoningKernel :: initOptions ( void )
 		) )
 		return true;
 
+	// register "useELSaturation" option -- 17/10/26
+	if ( KernelOptions.RegisterOption (
+		"useELSaturation",
+		"Option 'useELSaturation' allows one to classify the concepts whose \\bot-modules are in the EL fragment "
+		"by the consequence-based saturation instead of the tableau tests.",
+		ifOption::iotBool,
+		"true"
+		) )
+		return true;
+
 	// options for DLDag
 
 	// register "orSortSub" option (20/12/2004)
@@ -763,7 +874,8 @@ bool ReasoningKernel :: initOptions ( void )
 		"orSortSub",
 		"Option 'orSortSub' define the sorting order of OR vertices in the DAG used in subsumption tests. "
 		"Option has form of string 'Mop', where 'M' is a sort field (could be 'D' for depth, 'S' for size, 'F' "
-		"for frequency, and '0' for no sorting), 'o' is a order field (could be 'a' for ascending and 'd' "
+		"for frequency, 'A' for the adaptive order wrt the number of recent clashes of the disjuncts, and '0' "
+		"for no sorting), 'o' is a order field (could be 'a' for ascending and 'd' "
 		"for descending mode), and 'p' is a preference field (could be 'p' for preferencing non-generating "
 		"rules and 'n' for not doing so).",
 		ifOption::iotText,
@@ -781,6 +893,17 @@ bool ReasoningKernel :: initOptions ( void )
 		) )
 		return true;
 
+	// register "orSortSeed" option -- 17/10/26
+	if ( KernelOptions.RegisterOption (
+		"orSortSeed",
+		"Option 'orSortSeed' sets the seed used to break ties in the adaptive OR ordering (see orSortSub). "
+		"The same seed gives the same order; 0 keeps the DAG order for ties. The activities are kept per reasoner, "
+		"so with several classification threads the order depends on how the tests are spread over the threads.",
+		ifOption::iotInt,
+		"0"
+		) )
+		return true;
+
 	// options for ToDoTable
 
 	// register "IAOEFLG" option
@@ -826,6 +949,71 @@ bool ReasoningKernel :: initOptions ( void )
 		) )
 		return true;
 
+	// register "classificationThreads" option -- 17/10/26
+	if ( KernelOptions.RegisterOption (
+		"classificationThreads",
+		"Option 'classificationThreads' sets the number of threads that perform subsumption tests during classification. "
+		"Value 1 means that all the tests are performed in the main thread.",
+		ifOption::iotInt,
+		"1"
+		) )
+		return true;
+
+	// register "decompositionThreads" option -- 17/10/26
+	if ( KernelOptions.RegisterOption (
+		"decompositionThreads",
+		"Option 'decompositionThreads' sets the number of threads that build the modules for the atomic decomposition "
+		"wrt the syntactic locality. Value 1 means that all the modules are built in the main thread.",
+		ifOption::iotInt,
+		"1"
+		) )
+		return true;
+
+	// register "maxKeptGraphSize" option -- 17/10/26
+	if ( KernelOptions.RegisterOption (
+		"maxKeptGraphSize",
+		"Option 'maxKeptGraphSize' sets the number of completion graph nodes that are kept by the reasoner "
+		"after a test that required a larger graph; the rest of the memory is released. "
+		"Value 0 means that the memory is never released.",
+		ifOption::iotInt,
+		"0"
+		) )
+		return true;
+
+	// register "nogoodStoreSize" option -- 17/10/26
+	if ( KernelOptions.RegisterOption (
+		"nogoodStoreSize",
+		"Option 'nogoodStoreSize' sets the number of nogoods (sets of branching choices that lead to a clash) "
+		"that are kept during a single reasoning test and used to prune the known-to-fail choices. "
+		"Value 0 switches nogood learning off. Nogoods are learned only if backjumping is used.",
+		ifOption::iotInt,
+		"0"
+		) )
+		return true;
+
+	// register "useIncrementalSubsumption" option -- 17/10/26
+	if ( KernelOptions.RegisterOption (
+		"useIncrementalSubsumption",
+		"Option 'useIncrementalSubsumption' allows the reasoner to keep the model of a concept built by its "
+		"satisfiability test and to check the subsumptions of the concept by adding the negated candidate "
+		"subsumer to that model. The option works only if backjumping is used.",
+		ifOption::iotBool,
+		"true"
+		) )
+		return true;
+
+	// options for query answering
+
+	// register "queryCacheSize" option -- 17/10/26
+	if ( KernelOptions.RegisterOption (
+		"queryCacheSize",
+		"Option 'queryCacheSize' sets the number of complex concept queries which results are kept by the reasoner. "
+		"The least recently used results are forgotten first. Value 0 switches the query cache off.",
+		ifOption::iotInt,
+		"4096"
+		) )
+		return true;
+
 	// options for Blocking
 
 	// register "useLazyBlocking" option -- 08-03-04
@@ -31,9 +31,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "KnowledgeExplorer.h"
 #include "tOntologyAtom.h"	// types for AD
 #include "ModuleType.h"
+#include "tWorkerPool.h"	// TMutex
+#include "tQueryCache.h"
+#include "tCostProfile.h"
 
 class OntologyBasedModularizer;
 class AtomicDecomposer;
+class LocalityChecker;
 class TJNICache;	// cached JNI information
 class SaveLoadManager;
 
@@ -108,6 +112,10 @@ protected:	// types
 	typedef const std::vector<const TDLExpression*> TExprVec;
 		/// names to module signature map
 	typedef TBox::NameSigMap NameSigMap;
+		/// set of names
+	typedef std::set<const TNamedEntity*> NameSet;
+		/// entity to names map: all the names which module signatures contain the entity
+	typedef std::map<const TNamedEntity*, NameSet> SigNameMap;
 
 private:
 		/// options for the kernel and all related substructures
@@ -146,6 +154,8 @@ protected:	// members
 	TExpressionTranslator* pET;
 		/// name-signature map
 	NameSigMap Name2Sig;
+		/// inverted name-signature map (maintained together with Name2Sig)
+	SigNameMap Sig2Names;
 		/// ontology signature (used in incremental)
 	TSignature OntoSig;
 		/// trace vector for the last operation (set from the TBox trace-sets)
@@ -164,6 +174,8 @@ protected:	// members
 	TJNICache* JNICache;
 		/// name of an S/L context. do nothing if empty
 	SaveLoadManager* pSLManager;
+		/// costs of the concept tests; saved in the S/L context
+	TCostProfile CostProfile;
 
 	// Top/Bottom role names: if set, they will appear in all hierarchy-related output
 
@@ -182,6 +194,8 @@ protected:	// members
 	TProgressMonitor* pMonitor;
 		/// timeout value
 	unsigned long OpTimeout;
+		/// tokens of the running reasoning operations that allow other threads to cancel them; keeps the wall-clock timeout
+	TOperationControl Operations;
 		/// tell reasoner to use verbose output
 	bool verboseOutput;
 		/// allow reasoner to use undefined names in queries
@@ -199,6 +213,10 @@ protected:	// members
 	TConcept* cachedConcept;
 		/// cached query result (taxonomy position)
 	TaxonomyVertex* cachedVertex;
+		/// LRU cache of the results of the complex concept queries
+	TQueryCache QueryCache;
+		/// lock for the queries that use the query cache; queries about classified names do not need it
+	TMutex QueryLock;
 
 	// internal flags
 
@@ -240,6 +258,14 @@ protected:	// methods
 	void processKB ( KBStatus status );
 		/// classify/realise KB only if it is impossible to load results
 	void ClassifyOrLoad ( bool needIndividuals );
+		/// build the EL saturation for the concepts with the EL \bot-modules
+	void initELFReasoner ( void );
+		/// forget the TBox which preprocessing was interrupted, so the next query reloads it
+	void dropInterruptedTBox ( void )
+	{
+		clearTBox();
+		reasoningFailed = false;
+	}
 
 		/// get DLTree corresponding to an expression EXPR
 	DLTree* e ( const TExpr* expr )
@@ -284,8 +310,65 @@ protected:	// methods
 		clearQueryCache();
 		cachedConcept = NULL;
 		cachedVertex = NULL;
+		QueryCache.clear();
 		NeedTracing = false;
 	}
+		/// @return LRU cache entry for the query C; NULL if the results of C are not cached
+	TQueryCache::Entry* getQueryCacheEntry ( const TConceptExpr* C )
+	{
+		// names are answered by the taxonomy; the expressions are not unique if the expression cache is ignored
+		if ( !QueryCache.isActive() || ignoreExprCache || isNameOrConst(C) )
+			return NULL;
+		QueryCache.checkStatus(getStatus());
+		return &QueryCache.get(C);
+	}
+
+		/// @return classified concept named C if the queries about it need neither the query cache nor KB changes; NULL otherwise
+	TConcept* getFrozenConcept ( const TConceptExpr* C ) const
+	{
+		if ( !isKBClassified() )
+			return NULL;
+		const TDLConceptName* name = dynamic_cast<const TDLConceptName*>(C);
+		if ( name == NULL || name->getEntry() == NULL )
+			return NULL;
+		TConcept* concept = static_cast<TConcept*>(name->getEntry());
+		return isValid(concept->pName) && concept->getTaxVertex() != NULL ? concept : NULL;
+	}
+		/// @return taxonomy vertex of the query C; use the query cache iff NAMED is NULL
+	TaxonomyVertex* getQueryVertex ( const TConcept* named, const TConceptExpr* C )
+	{
+		if ( named != NULL )
+			return named->getTaxVertex();
+		TQueryCache::Entry* entry = getQueryCacheEntry(C);
+		if ( entry != NULL )
+		{
+			if ( entry->Vertex != NULL )
+			{
+				QueryCache.hit();
+				return entry->Vertex;
+			}
+			QueryCache.miss();
+		}
+		setUpCache ( C, csClassified );
+		if ( entry != NULL )
+		{	// the query vertex is re-used by the next query, so it should be copied
+			entry->setVertex ( cachedVertex, cachedVertex == getCTaxonomy()->getCurrent() );
+			entry->Sat = cachedVertex != getCTaxonomy()->getBottomVertex();
+		}
+		return cachedVertex;
+	}
+		/// apply actor::apply() to all DIRECT NC that subsume the role domain expression C; QueryLock should be taken
+	template<class Actor>
+	void getDomainConcepts ( const TConceptExpr* C, bool direct, Actor& actor )
+	{
+		TaxonomyVertex* v = getQueryVertex ( NULL, C );
+		actor.clear();
+		Taxonomy* tax = getCTaxonomy();
+		if ( direct )	// gets an exact domain is named concept; otherwise, set of the most specific concepts
+			tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/true, /*upDirection=*/true> ( v, actor );
+		else			// gets all named classes that are in the domain of a role
+			tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/true> ( v, actor );
+	}
 
 		/// build and set a cache for an individual I wrt role R
 	CIVec buildRelatedCache ( TIndividual* I, const TRole* R );
@@ -329,8 +412,21 @@ protected:	// methods
 		/// @return true iff C is satisfiable
 	bool checkSat ( const TConceptExpr* C )
 	{
+		TQueryCache::Entry* entry = getQueryCacheEntry(C);
+		if ( entry != NULL )
+		{
+			if ( entry->Sat >= 0 )
+			{
+				QueryCache.hit();
+				return entry->Sat != 0;
+			}
+			QueryCache.miss();
+		}
 		setUpCache ( C, csSat );
-		return getTBox()->isSatisfiable(cachedConcept);
+		bool ret = getTBox()->isSatisfiable(cachedConcept);
+		if ( entry != NULL )
+			entry->Sat = ret;
+		return ret;
 	}
 		/// @return true iff C [= D holds
 	bool checkSub ( TConcept* C, TConcept* D );
@@ -502,6 +598,10 @@ protected:	// methods
 	void setupSig ( const TNamedEntity* entity, const AxiomVec& Module );
 		/// setup Name2Sig for a given ENTITY
 	void setupSig ( const TNamedEntity* entity ) { setupSig ( entity, Ontology.getAxioms() ); }
+		/// add (if ADD is true) or remove ENTITY as a name for every element of SIG in the Sig2Names
+	void indexSig ( const TNamedEntity* entity, const TSignature& sig, bool add );
+		/// add the names whose module signatures might make AX non-local to CANDIDATES; @return true iff all names are candidates
+	bool addLocalityCandidates ( TDLAxiom* ax, LocalityChecker* lc, NameSet& Candidates );
 		/// build signature for ENTITY and all dependent entities from toProcess; look for modules in Module;
 	void buildSignature ( const TNamedEntity* entity, const AxiomVec& Module, std::set<const TNamedEntity*>& toProcess );
 		/// initialise the incremental bits on full reload
@@ -605,6 +705,13 @@ public:	// general staff
 		getTBox()->clearQueryConcept();	// get rid of the query leftovers
 		getTBox()->writeReasoningResult ( o, time );
 	}
+		/// add the total reasoning statistic to VALUES; the values are indexed by the statistic names.
+		/// The tactic, branch and classification counters are always there; the detailed ones need USE_REASONING_STATISTICS
+	void getReasoningStatistic ( std::map<std::string, unsigned long>& values ) const
+	{
+		if ( pTBox != NULL )
+			pTBox->getReasoningStatistic(values);
+	}
 
 		/// set timeout value to VALUE
 	void setOperationTimeout ( unsigned long value )
@@ -613,6 +720,10 @@ public:	// general staff
 		if ( pTBox != NULL )
 			pTBox->setTestTimeout(value);
 	}
+		/// set the wall-clock timeout of a reasoning operation (consistency check, classification, realisation or a query) to VALUE ms; 0 means no timeout
+	void setOperationWallTimeout ( unsigned long value ) { Operations.setTimeout(value); }
+		/// stop the reasoning operations in progress; could be called from any thread. The operations started later are not affected
+	void cancelOperation ( void ) { Operations.cancel(); }
 		/// choose whether axiom splitting should be used
 	void setAxiomSplitting ( bool value ) { useAxiomSplitting = value; }
 		/// choose whether TExpr cache should be ignored
@@ -624,6 +735,11 @@ public:	// general staff
 		/// choose whether the loaded ontology should be dumped as a LISP one
 	void setDumpOntology ( bool value ) { dumpOntology = value; }
 
+		/// get number of the complex concept queries answered from the query cache
+	unsigned long getNQueryCacheHits ( void ) const { return QueryCache.getNHits(); }
+		/// get number of the complex concept queries that were not answered from the query cache
+	unsigned long getNQueryCacheMisses ( void ) const { return QueryCache.getNMisses(); }
+
 	//----------------------------------------------
 	//-- Tracing support
 	//----------------------------------------------
@@ -662,10 +778,12 @@ public:
 
 		pTBox = new TBox ( getOptions(), TopORoleName, BotORoleName, TopDRoleName, BotDRoleName );
 		pTBox->setTestTimeout(OpTimeout);
+		pTBox->setOperationControl(&Operations);
 		pTBox->setProgressMonitor(pMonitor);
 		pTBox->setVerboseOutput(verboseOutput);
 		pTBox->setUseUndefinedNames(useUndefinedNames);
 		pET = new TExpressionTranslator(*pTBox);
+		QueryCache.setCapacity ( KernelOptions.getInt("queryCacheSize") );
 		initCacheAndFlags();
 		return false;
 	}
@@ -854,6 +972,7 @@ public:
 		/// @return true iff object role is functional
 	bool isFunctional ( const TORoleExpr* R )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isFunctional()" );
 		if ( unlikely(r->isTop()) )
@@ -866,6 +985,7 @@ public:
 		/// @return true iff data role is functional
 	bool isFunctional ( const TDRoleExpr* R )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isFunctional()" );
 		if ( unlikely(r->isTop()) )
@@ -878,6 +998,7 @@ public:
 		/// @return true iff role is inverse-functional
 	bool isInverseFunctional ( const TORoleExpr* R )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isInverseFunctional()" )->inverse();
 		if ( unlikely(r->isTop()) )
@@ -890,6 +1011,7 @@ public:
 		/// @return true iff role is transitive
 	bool isTransitive ( const TORoleExpr* R )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isTransitive()" );
 		if ( unlikely(r->isTop()) )
@@ -904,6 +1026,7 @@ public:
 		/// @return true iff role is symmetric
 	bool isSymmetric ( const TORoleExpr* R )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isSymmetric()" );
 		if ( unlikely(r->isTop()) )
@@ -918,6 +1041,7 @@ public:
 		/// @return true iff role is asymmetric
 	bool isAsymmetric ( const TORoleExpr* R )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isAsymmetric()" );
 		if ( unlikely(r->isTop()) )
@@ -932,6 +1056,7 @@ public:
 		/// @return true iff role is reflexive
 	bool isReflexive ( const TORoleExpr* R )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isReflexive()" );
 		if ( unlikely(r->isTop()) )
@@ -946,6 +1071,7 @@ public:
 		/// @return true iff role is irreflexive
 	bool isIrreflexive ( const TORoleExpr* R )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isIrreflexive()" );
 		if ( unlikely(r->isTop()) )
@@ -960,6 +1086,7 @@ public:
 		/// @return true if R is a sub-role of S
 	bool isSubRoles ( const TORoleExpr* R, const TORoleExpr* S )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isSubRoles()" );
 		TRole* s = getRole ( S, "Role expression expected in isSubRoles()" );
@@ -981,6 +1108,7 @@ public:
 		/// @return true if R is a sub-role of S
 	bool isSubRoles ( const TDRoleExpr* R, const TDRoleExpr* S )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isSubRoles()" );
 		TRole* s = getRole ( S, "Role expression expected in isSubRoles()" );
@@ -1002,6 +1130,7 @@ public:
 		/// @return true iff two roles are disjoint
 	bool isDisjointRoles ( const TORoleExpr* R, const TORoleExpr* S )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isDisjointRoles()" );
 		TRole* s = getRole ( S, "Role expression expected in isDisjointRoles()" );
@@ -1014,6 +1143,7 @@ public:
 		/// @return true iff two roles are disjoint
 	bool isDisjointRoles ( const TDRoleExpr* R, const TDRoleExpr* S )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isDisjointRoles()" );
 		TRole* s = getRole ( S, "Role expression expected in isDisjointRoles()" );
@@ -1028,6 +1158,7 @@ public:
 		/// @return true if R is a super-role of a chain holding in the args
 	bool isSubChain ( const TORoleExpr* R )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();	// ensure KB is ready to answer the query
 		TRole* r = getRole ( R, "Role expression expected in isSubChain()" );
 		if ( unlikely(r->isTop()) )
@@ -1037,10 +1168,26 @@ public:
 
 	// single satisfiability
 
+	// Thread-safe queries: once the KB is classified (realised for the instance queries) and is not
+	// changed, isSatisfiable(), isSubsumedBy(), get{Sup,Sub,Equivalent,Disjoint}Concepts(),
+	// get{O,D}RoleDomain(), getRoleRange(), get{Direct}Instances() and getTypes() could be called
+	// from several threads. Only the ones about classified concept names (satisfiability, subsumption,
+	// sub-, super- and equivalent concepts, instances) run concurrently, as they just traverse the taxonomy.
+	// The rest (complex concepts, fresh names, disjoint concepts, role domains and ranges, types) use
+	// the single reasoner, the DAG and the query cache of the kernel, so they are serialized by QueryLock
+	// and run one at a time.
+	// The query expressions should be created beforehand, as the expression manager is not shared.
+	// Every query that might run the reasoner is a separate operation wrt the cancellation and the wall-clock timeout.
+
 		/// @return true iff C is satisfiable
 	bool isSatisfiable ( const TConceptExpr* C )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();
+		// classified name is unsatisfiable iff it is in the bottom vertex
+		if ( const TConcept* named = getFrozenConcept(C) )
+			return named->getTaxVertex() != getCTaxonomy()->getBottomVertex();
+		TMutexLock lock(QueryLock);
 		try { return checkSat(C); }
 		catch ( const EFPPCantRegName& crn )
 		{
@@ -1053,7 +1200,13 @@ public:
 		/// @return true iff C [= D holds
 	bool isSubsumedBy ( const TConceptExpr* C, const TConceptExpr* D )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();
+		// classified names: use taxonomy only
+		TConcept* pC = getFrozenConcept(C), *pD = getFrozenConcept(D);
+		if ( pC != NULL && pD != NULL )
+			return checkSub ( pC, pD );
+		TMutexLock lock(QueryLock);
 		if ( isNameOrConst(D) && likely(isNameOrConst(C)) )
 			return checkSub ( getTBox()->getCI(TreeDeleter(e(C))), getTBox()->getCI(TreeDeleter(e(D))) );
 		DLTree* nD = createSNFNot(e(D));
@@ -1066,6 +1219,7 @@ public:
 	{
 		if ( C == D )	// easy case
 			return true;
+		TOperationGuard guard(&Operations);
 		preprocessKB();
 		if ( isKBClassified() )
 		{	// try to detect C=D wrt named concepts
@@ -1087,47 +1241,58 @@ public:
 	template<class Actor>
 	void getSupConcepts ( const TConceptExpr* C, bool direct, Actor& actor )
 	{
+		TOperationGuard guard(&Operations);
 		classifyKB();	// ensure KB is ready to answer the query
-		setUpCache ( C, csClassified );
+		const TConcept* named = getFrozenConcept(C);
+		TMutexLock lock ( QueryLock, named == NULL );
+		TaxonomyVertex* v = getQueryVertex ( named, C );
 		actor.clear();
 		Taxonomy* tax = getCTaxonomy();
 		if ( direct )
-			tax->getRelativesInfo</*needCurrent=*/false, /*onlyDirect=*/true, /*upDirection=*/true> ( cachedVertex, actor );
+			tax->getRelativesInfo</*needCurrent=*/false, /*onlyDirect=*/true, /*upDirection=*/true> ( v, actor );
 		else
-			tax->getRelativesInfo</*needCurrent=*/false, /*onlyDirect=*/false, /*upDirection=*/true> ( cachedVertex, actor );
+			tax->getRelativesInfo</*needCurrent=*/false, /*onlyDirect=*/false, /*upDirection=*/true> ( v, actor );
 	}
 		/// apply actor::apply() to all DIRECT sub-concepts of [complex] C
 	template<class Actor>
 	void getSubConcepts ( const TConceptExpr* C, bool direct, Actor& actor )
 	{
+		TOperationGuard guard(&Operations);
 		classifyKB();	// ensure KB is ready to answer the query
-		setUpCache ( C, csClassified );
+		const TConcept* named = getFrozenConcept(C);
+		TMutexLock lock ( QueryLock, named == NULL );
+		TaxonomyVertex* v = getQueryVertex ( named, C );
 		actor.clear();
 		Taxonomy* tax = getCTaxonomy();
 		if ( direct )
-			tax->getRelativesInfo</*needCurrent=*/false, /*onlyDirect=*/true, /*upDirection=*/false> ( cachedVertex, actor );
+			tax->getRelativesInfo</*needCurrent=*/false, /*onlyDirect=*/true, /*upDirection=*/false> ( v, actor );
 		else
-			tax->getRelativesInfo</*needCurrent=*/false, /*onlyDirect=*/false, /*upDirection=*/false> ( cachedVertex, actor );
+			tax->getRelativesInfo</*needCurrent=*/false, /*onlyDirect=*/false, /*upDirection=*/false> ( v, actor );
 	}
 		/// apply actor::apply() to all synonyms of [complex] C
 	template<class Actor>
 	void getEquivalentConcepts ( const TConceptExpr* C, Actor& actor )
 	{
+		TOperationGuard guard(&Operations);
 		classifyKB();	// ensure KB is ready to answer the query
-		setUpCache ( C, csClassified );
+		const TConcept* named = getFrozenConcept(C);
+		TMutexLock lock ( QueryLock, named == NULL );
+		TaxonomyVertex* v = getQueryVertex ( named, C );
 		actor.clear();
-		actor.apply(*cachedVertex);
+		actor.apply(*v);
 	}
 		/// apply actor::apply() to all named concepts disjoint with [complex] C
 	template<class Actor>
 	void getDisjointConcepts ( const TConceptExpr* C, Actor& actor )
 	{
+		TOperationGuard guard(&Operations);
 		classifyKB();	// ensure KB is ready to answer the query
-		setUpCache ( getExpressionManager()->Not(C), csClassified );
+		TMutexLock lock(QueryLock);
+		TaxonomyVertex* v = getQueryVertex ( NULL, getExpressionManager()->Not(C) );
 		actor.clear();
 		Taxonomy* tax = getCTaxonomy();
 		// we are looking for all sub-concepts of (not C) (including synonyms to it)
-		tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/false> ( cachedVertex, actor );
+		tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/false> ( v, actor );
 	}
 
 	// role hierarchy
@@ -1174,32 +1339,29 @@ public:
 	template<class Actor>
 	void getORoleDomain ( const TORoleExpr* r, bool direct, Actor& actor )
 	{
+		TOperationGuard guard(&Operations);
 		classifyKB();	// ensure KB is ready to answer the query
-		setUpCache ( getExpressionManager()->Exists ( r, getExpressionManager()->Top() ), csClassified );
-		actor.clear();
-		Taxonomy* tax = getCTaxonomy();
-		if ( direct )	// gets an exact domain is named concept; otherwise, set of the most specific concepts
-			tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/true, /*upDirection=*/true> ( cachedVertex, actor );
-		else			// gets all named classes that are in the domain of a role
-			tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/true> ( cachedVertex, actor );
+		TMutexLock lock(QueryLock);
+		getDomainConcepts ( getExpressionManager()->Exists ( r, getExpressionManager()->Top() ), direct, actor );
 	}
 		/// apply actor::apply() to all DIRECT NC that are in the domain of data role R
 	template<class Actor>
 	void getDRoleDomain ( const TDRoleExpr* r, bool direct, Actor& actor )
 	{
+		TOperationGuard guard(&Operations);
 		classifyKB();	// ensure KB is ready to answer the query
-		setUpCache ( getExpressionManager()->Exists ( r, getExpressionManager()->DataTop() ), csClassified );
-		actor.clear();
-		Taxonomy* tax = getCTaxonomy();
-		if ( direct )	// gets an exact domain is named concept; otherwise, set of the most specific concepts
-			tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/true, /*upDirection=*/true> ( cachedVertex, actor );
-		else			// gets all named classes that are in the domain of a role
-			tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/true> ( cachedVertex, actor );
+		TMutexLock lock(QueryLock);
+		getDomainConcepts ( getExpressionManager()->Exists ( r, getExpressionManager()->DataTop() ), direct, actor );
 	}
 		/// apply actor::apply() to all DIRECT NC that are in the range of [complex] R
 	template<class Actor>
 	void getRoleRange ( const TORoleExpr* r, bool direct, Actor& actor )
-		{ getORoleDomain ( getExpressionManager()->Inverse(r), direct, actor ); }
+	{
+		TOperationGuard guard(&Operations);
+		classifyKB();	// ensure KB is ready to answer the query
+		TMutexLock lock(QueryLock);
+		getDomainConcepts ( getExpressionManager()->Exists ( getExpressionManager()->Inverse(r), getExpressionManager()->Top() ), direct, actor );
+	}
 
 	// instances
 
@@ -1207,20 +1369,23 @@ public:
 	template<class Actor>
 	void getDirectInstances ( const TConceptExpr* C, Actor& actor )
 	{
+		TOperationGuard guard(&Operations);
 		realiseKB();	// ensure KB is ready to answer the query
-		setUpCache ( C, csClassified );
+		const TConcept* named = getFrozenConcept(C);
+		TMutexLock lock ( QueryLock, named == NULL );
+		TaxonomyVertex* v = getQueryVertex ( named, C );
 		actor.clear();
 
 		// implement 1-level check by hand
 
 		// if the root vertex contains individuals -- we are done
-		if ( actor.apply(*cachedVertex) )
+		if ( actor.apply(*v) )
 			return;
 
 		// if not, just go 1 level down and apply the actor regardless of what's found
 		// FIXME!! check again after bucket-method will be implemented
-		for ( TaxonomyVertex::iterator p = cachedVertex->begin(/*upDirection=*/false),
-				p_end = cachedVertex->end(/*upDirection=*/false); p != p_end; ++p )
+		for ( TaxonomyVertex::iterator p = v->begin(/*upDirection=*/false),
+				p_end = v->end(/*upDirection=*/false); p != p_end; ++p )
 			actor.apply(**p);
 	}
 
@@ -1228,18 +1393,25 @@ public:
 	template<class Actor>
 	void getInstances ( const TConceptExpr* C, Actor& actor )
 	{	// FIXME!! check for Racer's/IS approach
+		TOperationGuard guard(&Operations);
 		realiseKB();	// ensure KB is ready to answer the query
-		setUpCache ( C, csClassified );
+		const TConcept* named = getFrozenConcept(C);
+		TMutexLock lock ( QueryLock, named == NULL );
+		TaxonomyVertex* v = getQueryVertex ( named, C );
 		actor.clear();
 		Taxonomy* tax = getCTaxonomy();
-		tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/false> ( cachedVertex, actor );
+		tax->getRelativesInfo</*needCurrent=*/true, /*onlyDirect=*/false, /*upDirection=*/false> ( v, actor );
 	}
+		/// set RESULT into the set of all instances of given [complex] C; the KB is not realised for that
+	void retrieveInstances ( const TConceptExpr* C, IndividualSet& Result );
 
 		/// apply actor::apply() to all DIRECT concepts that are types of an individual I
 	template<class Actor>
 	void getTypes ( const TIndividualExpr* I, bool direct, Actor& actor )
 	{
+		TOperationGuard guard(&Operations);
 		realiseKB();	// ensure KB is ready to answer the query
+		TMutexLock lock(QueryLock);
 		setUpCache ( getExpressionManager()->OneOf(I), csClassified );
 		actor.clear();
 		Taxonomy* tax = getCTaxonomy();
@@ -1252,12 +1424,14 @@ public:
 	template<class Actor>
 	void getSameAs ( const TIndividualExpr* I, Actor& actor )
 	{
+		TOperationGuard guard(&Operations);
 		realiseKB();	// ensure KB is ready to answer the query
 		getEquivalentConcepts ( getExpressionManager()->OneOf(I), actor );
 	}
 		/// @return true iff I and J refer to the same individual
 	bool isSameIndividuals ( const TIndividualExpr* I, const TIndividualExpr* J )
 	{
+		TOperationGuard guard(&Operations);
 		realiseKB();
 		TIndividual* i = getIndividual ( I, "Only known individuals are allowed in the isSameAs()" );
 		TIndividual* j = getIndividual ( J, "Only known individuals are allowed in the isSameAs()" );
@@ -1266,6 +1440,7 @@ public:
 		/// @return true iff individual I is instance of given [complex] C
 	bool isInstance ( const TIndividualExpr* I, const TConceptExpr* C )
 	{
+		TOperationGuard guard(&Operations);
 		realiseKB();	// ensure KB is ready to answer the query
 		getIndividual ( I, "individual name expected in the isInstance()" );
 		// FIXME!! this way a new concept is created; could be done more optimal
@@ -1288,6 +1463,7 @@ public:
 		/// build a completion tree for a concept expression C (no caching as it breaks the idea of KE). @return the root node
 	const TCGNode* buildCompletionTree ( const TConceptExpr* C )
 	{
+		TOperationGuard guard(&Operations);
 		preprocessKB();
 		setUpCache ( C, csSat );
 		const TCGNode* ret = getTBox()->buildCompletionTree(cachedConcept);
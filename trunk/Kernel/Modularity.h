@@ -52,6 +52,12 @@ protected:	// members
 	AxiomVec Module;
 		/// pointer to a sig index; if not NULL then use optimized algo
 	SigIndex sigIndex;
+		/// sig index that is used for the extraction: either the own one or a shared one
+	const SigIndex* pSigIndex;
+		/// in-module flags of the axioms (indexed by the axiom id) if the own flags are used
+	std::vector<bool> InModule;
+		/// in-search-space flags of the axioms (indexed by the axiom id) if the own flags are used
+	std::vector<bool> InSS;
 		/// queue of unprocessed entities
 	std::queue<const TNamedEntity*> WorkQueue;
 		/// number of locality check calls
@@ -60,8 +66,38 @@ protected:	// members
 	unsigned long long nNonLocal;
 		/// true if no atoms are processed ATM
 	bool noAtomsProcessing;
+		/// true iff the module flags are kept in the modularizer rather than in the axioms
+	bool ownFlags;
+		/// true iff all the used axioms are in the search space (own flags only)
+	bool allInSS;
 
 protected:	// methods
+		/// @return true iff an AXiom is in the module
+	bool isInModule ( const TDLAxiom* ax ) const { return ownFlags ? InModule[ax->getId()] : ax->isInModule(); }
+		/// set the in-module flag of an AXiom to FLAG
+	void setInModule ( TDLAxiom* ax, bool flag )
+	{
+		if ( ownFlags )
+			InModule[ax->getId()] = flag;
+		else
+			ax->setInModule(flag);
+	}
+		/// @return true iff an AXiom is in the search space
+	bool isInSS ( const TDLAxiom* ax ) const
+	{
+		if ( !ownFlags )
+			return ax->isInSS();
+		return allInSS ? ax->isUsed() : InSS[ax->getId()];
+	}
+		/// set the in-search-space flag of an AXiom to FLAG
+	void setInSS ( TDLAxiom* ax, bool flag )
+	{
+		if ( ownFlags )
+			InSS[ax->getId()] = flag;
+		else
+			ax->setInSS(flag);
+	}
+
 		/// update SIG wrt the axiom signature
 	void addAxiomSig ( const TSignature& axiomSig )
 	{
@@ -75,7 +111,7 @@ protected:	// methods
 		/// add an axiom to a module
 	void addAxiomToModule ( TDLAxiom* axiom )
 	{
-		axiom->setInModule(true);
+		setInModule ( axiom, true );
 		Module.push_back(axiom);
 		// update the signature
 		addAxiomSig(axiom->getSignature());
@@ -111,7 +147,7 @@ protected:	// methods
 	void addNonLocal ( const AxiomVec& AxSet, bool noCheck )
 	{
 		for ( SigIndex::const_iterator q = AxSet.begin(), q_end = AxSet.end(); q != q_end; ++q )
-			if ( !(*q)->isInModule() && (*q)->isInSS() ) // in the given range but not in module yet
+			if ( !isInModule(*q) && isInSS(*q) ) // in the given range but not in module yet
 				addNonLocal ( *q, noCheck );
 	}
 		/// build a module traversing axioms by a signature
@@ -121,14 +157,14 @@ protected:	// methods
 		for ( TSignature::iterator p = sig.begin(), p_end = sig.end(); p != p_end; ++p )
 			WorkQueue.push(*p);
 		// add all the axioms that are non-local wrt given value of a top-locality
-		addNonLocal ( sigIndex.getNonLocal(sig.topCLocal()), /*noCheck=*/true );
+		addNonLocal ( pSigIndex->getNonLocal(sig.topCLocal()), /*noCheck=*/true );
 		// main cycle
 		while ( !WorkQueue.empty() )
 		{
 			const TNamedEntity* entity = WorkQueue.front();
 			WorkQueue.pop();
 			// for all the axioms that contains entity in their signature
-			addNonLocal ( sigIndex.getAxioms(entity), /*noCheck=*/false );
+			addNonLocal ( pSigIndex->getAxioms(entity), /*noCheck=*/false );
 		}
 	}
 		/// extract module wrt presence of a sig index
@@ -136,16 +172,23 @@ protected:	// methods
 	{
 		Module.clear();
 		Module.reserve(end-begin);
-		// clear the module flag in the input
 		const_iterator p;
-		for ( p = begin; p != end; ++p )
-			(*p)->setInModule(false);
-		for ( p = begin; p != end; ++p )
-			if ( (*p)->isUsed() )
-				(*p)->setInSS(true);
+		// clear the module flag in the input; the own flags are always clear here
+		if ( !ownFlags )
+			for ( p = begin; p != end; ++p )
+				(*p)->setInModule(false);
+		if ( !allInSS )
+			for ( p = begin; p != end; ++p )
+				if ( (*p)->isUsed() )
+					setInSS ( *p, true );
 		extractModuleQueue();
-		for ( p = begin; p != end; ++p )
-			(*p)->setInSS(false);
+		if ( !allInSS )
+			for ( p = begin; p != end; ++p )
+				setInSS ( *p, false );
+		// keep the own flags clear
+		if ( ownFlags )
+			for ( p = Module.begin(); p != Module.end(); ++p )
+				InModule[(*p)->getId()] = false;
 	}
 
 public:		// interface
@@ -153,9 +196,25 @@ public:		// interface
 	TModularizer ( bool useSem )
 		: Checker ( useSem ? (LocalityChecker*) new SemanticLocalityChecker(&sig) : (LocalityChecker*) new SyntacticLocalityChecker(&sig) )
 		, sigIndex(Checker)
+		, pSigIndex(&sigIndex)
 		, nChecks(0)
 		, nNonLocal(0)
 		, noAtomsProcessing(true)
+		, ownFlags(false)
+		, allInSS(false)
+		{}
+		/// init c'tor for the parallel extraction: use syntactic locality, a shared sig INDEX and own flags for the axioms with ids less than MAXID
+	TModularizer ( const SigIndex* index, unsigned int maxId )
+		: Checker ( new SyntacticLocalityChecker(&sig) )
+		, sigIndex(Checker)
+		, pSigIndex(index)
+		, InModule(maxId,false)
+		, InSS(maxId,false)
+		, nChecks(0)
+		, nNonLocal(0)
+		, noAtomsProcessing(true)
+		, ownFlags(true)
+		, allInSS(false)
 		{}
 		// d'tor
 	~TModularizer ( void ) { delete Checker; }
@@ -176,6 +235,8 @@ public:		// interface
 		sig = signature;
 		sig.setLocality(topLocality);
  		extractModule ( begin, end );
+		// the rest of the passes use the module as a search space
+		allInSS = false;
 
 		if ( type != M_STAR )
 			return;
@@ -200,6 +261,12 @@ public:		// interface
 		/// extract module wrt SIGNATURE and TYPE from O
 	void extract ( const TOntology& O, const TSignature& signature, ModuleType type )
 		{ extract ( O.getAxioms(), signature, type ); }
+		/// extract module wrt SIGNATURE and TYPE from all the used axioms VEC of an ontology; no search space is marked for the own flags
+	void extractFromUsed ( const AxiomVec& Vec, const TSignature& signature, ModuleType type )
+	{
+		allInSS = ownFlags;
+		extract ( Vec, signature, type );
+	}
 		/// @return true iff the axiom AX is a tautology wrt given type
 	bool isTautology ( TDLAxiom* ax, ModuleType type )
 	{
@@ -0,0 +1,105 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "ParallelABoxChecker.h"
+#include "ReasonerNom.h"
+
+ParallelABoxChecker :: ParallelABoxChecker ( TBox& kb, const TABoxPartition& partition, unsigned int nThreads )
+	: tBox(kb)
+	, Partition(partition)
+	, Pool(nThreads)
+	, nDropped(0)
+{
+	// reasoners are created here as their c'tors change the TBox
+	for ( unsigned int i = 0; i < nThreads; ++i )
+	{
+		NominalReasoner* reasoner = new NominalReasoner(tBox);
+		reasoner->setPartition(&Partition);
+		reasoner->setBlockingMethod ( tBox.isIRinQuery(), tBox.isNRinQuery() );
+		Reasoners.push_back(reasoner);
+	}
+}
+
+ParallelABoxChecker :: ~ParallelABoxChecker ( void )
+{
+	Pool.stop();
+	for ( std::vector<NominalReasoner*>::iterator p = Reasoners.begin(), p_end = Reasoners.end(); p != p_end; ++p )
+		delete *p;
+}
+
+void
+ParallelABoxChecker :: run ( void )
+{
+	Results.assign ( Batch.size(), -1 );
+	Caches.assign ( Batch.size(), CacheVector() );
+	Merges.assign ( Batch.size(), MergeVector() );
+	Pool.run ( *this, Batch.size() );
+
+	// the caches and merges are registered in the main thread; a cache of an individual is set only once
+	for ( unsigned int i = 0; i < Batch.size(); ++i )
+	{
+		if ( Results[i] == -2 )
+			++nDropped;
+		for ( CacheVector::iterator p = Caches[i].begin(), p_end = Caches[i].end(); p != p_end; ++p )
+			if ( Results[i] > 0 && tBox.DLHeap.getCache(p->first->pName) == NULL )
+				tBox.DLHeap.setCache ( p->first->pName, p->second );
+			else
+				delete p->second;
+		if ( Results[i] > 0 )
+			for ( MergeVector::const_iterator p = Merges[i].begin(), p_end = Merges[i].end(); p != p_end; ++p )
+				tBox.SameI[p->first] = p->second;
+		Caches[i].clear();
+		Merges[i].clear();
+	}
+}
+
+void
+ParallelABoxChecker :: process ( unsigned int worker, unsigned int item )
+{
+	NominalReasoner* reasoner = Reasoners[worker];
+
+	try
+	{
+		std::set<unsigned int> comps;
+		comps.insert(Batch[item]);
+		reasoner->initCloud(comps);
+		bool result = reasoner->checkNominalCloud();
+		// the result of the cancelled test is meaningless
+		if ( tBox.isCancelled() )
+			return;
+		Results[item] = result ? 1 : 0;
+		if ( !result )
+			return;
+
+		const TABoxPartition::SingletonVector& Inds = Partition[Batch[item]].Individuals;
+		for ( TABoxPartition::SingletonVector::const_iterator p = Inds.begin(), p_end = Inds.end(); p != p_end; ++p )
+		{
+			Caches[item].push_back(std::make_pair ( static_cast<const TIndividual*>(*p), reasoner->buildNominalCache(*p) ));
+			bool det;
+			TIndividual* blocker = reasoner->getMergedIndividual ( *p, det );
+			if ( blocker != NULL )
+				Merges[item].push_back(std::make_pair ( *p, std::make_pair ( blocker, det ) ));
+		}
+	}
+	catch(...)
+	{
+		// timeout or other problem: leave the component to the main thread
+		Results[item] = -2;
+	}
+}
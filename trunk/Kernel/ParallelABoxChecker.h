@@ -0,0 +1,99 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef PARALLELABOXCHECKER_H
+#define PARALLELABOXCHECKER_H
+
+#include <vector>
+
+#include "tWorkerPool.h"
+
+class TBox;
+class TABoxPartition;
+class TIndividual;
+class NominalReasoner;
+class modelCacheInterface;
+
+/**
+ *	Checks the consistency of the independent ABox components in a pool of
+ *	threads. Every thread has its own nominal reasoner working over the
+ *	shared (read-only) DAG of the TBox; the nominal nodes of the individuals
+ *	of different components do not intersect. The pseudo-model caches of the
+ *	individuals of the consistent components and the merges of individuals
+ *	found in their models are passed to the TBox, as the main reasoner does
+ *	for the components it checks itself.
+ */
+class ParallelABoxChecker: public TWorkerPool::Job
+{
+protected:	// types
+		/// caches of the individuals of a component
+	typedef std::vector<std::pair<const TIndividual*, modelCacheInterface*> > CacheVector;
+		/// individuals of a component merged to other individuals together with the determinism flags
+	typedef std::vector<std::pair<TIndividual*, std::pair<TIndividual*, bool> > > MergeVector;
+
+protected:	// members
+		/// host TBox
+	TBox& tBox;
+		/// components to check
+	const TABoxPartition& Partition;
+		/// pool of the worker threads
+	TWorkerPool Pool;
+		/// reasoner for every worker
+	std::vector<NominalReasoner*> Reasoners;
+		/// indices of the components to check
+	std::vector<unsigned int> Batch;
+		/// results of the checks: 1 if consistent, 0 if not, -1 if unknown, -2 if the worker failed to make it
+	std::vector<int> Results;
+		/// caches of the individuals for every component in the batch
+	std::vector<CacheVector> Caches;
+		/// merged individuals for every component in the batch
+	std::vector<MergeVector> Merges;
+		/// number of checks the workers failed to make (timeout or other problem); they are re-done by the main thread
+	unsigned long nDropped;
+
+private:	// no copy
+		/// no copy c'tor
+	ParallelABoxChecker ( const ParallelABoxChecker& );
+		/// no assignment
+	ParallelABoxChecker& operator = ( const ParallelABoxChecker& );
+
+public:		// interface
+		/// c'tor: create NTHREADS workers to check components of the PARTITION of a given KB
+	ParallelABoxChecker ( TBox& kb, const TABoxPartition& partition, unsigned int nThreads );
+		/// d'tor: stop all the workers
+	virtual ~ParallelABoxChecker ( void );
+
+		/// add the component number I to the batch
+	void addComponent ( unsigned int i ) { Batch.push_back(i); }
+		/// check all the components from the batch; keep the caches and merges of the individuals of the consistent ones
+	void run ( void );
+		/// get number of the components in the batch
+	unsigned int size ( void ) const { return Batch.size(); }
+		/// get index of the component number I in the batch
+	unsigned int getComponent ( unsigned int i ) const { return Batch[i]; }
+		/// get the result of the check of the component number I in the batch: 1 if consistent, 0 if not, <0 if unknown
+	int getResult ( unsigned int i ) const { return Results[i]; }
+		/// get number of the checks the workers failed to make
+	unsigned long getNDropped ( void ) const { return nDropped; }
+
+		/// check a component number ITEM of the batch in the thread number WORKER
+	virtual void process ( unsigned int worker, unsigned int item );
+}; // ParallelABoxChecker
+
+#endif
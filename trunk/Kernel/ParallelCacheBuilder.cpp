@@ -0,0 +1,225 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include <algorithm>
+
+#include "ParallelCacheBuilder.h"
+#include "Reasoner.h"
+
+ParallelCacheBuilder :: ParallelCacheBuilder ( TBox& kb, unsigned int nThreads )
+	: tBox(kb)
+	, Pool(nThreads)
+	, Batch(NULL)
+	, nBuilt(0)
+	, nDropped(0)
+{
+	// reasoners are created here as their c'tors change the TBox
+	for ( unsigned int i = 0; i < nThreads; ++i )
+		Reasoners.push_back(new DlSatTester(tBox));
+}
+
+ParallelCacheBuilder :: ~ParallelCacheBuilder ( void )
+{
+	Pool.stop();
+	for ( std::vector<DlSatTester*>::iterator p = Reasoners.begin(), p_end = Reasoners.end(); p != p_end; ++p )
+		delete *p;
+	// caches that were not installed
+	for ( PointVector::iterator p = Points.begin(), p_end = Points.end(); p != p_end; ++p )
+		delete p->cache;
+}
+
+/// gather the points the cache of P depends on; @return 1 + the max level of them (0 if there are none)
+unsigned int
+ParallelCacheBuilder :: gatherDeps ( BipolarPointer p, const TConcept* root, bool pos )
+{
+	// the same traversal as in DlSatTester::prepareCascadedCache()
+	if ( InProcess.find(p) != InProcess.end() )	// cycle
+		return 0;
+
+	const DLVertex& v = tBox.DLHeap[p];
+	bool posV = isPositive(p);
+	if ( v.getCache(posV) != NULL )
+		return 0;
+	// the entries shared by several cascades are traversed only once
+	std::map<BipolarPointer, unsigned int>::const_iterator found = DepLevels.find(p);
+	if ( found != DepLevels.end() )
+		return found->second;
+
+	unsigned int ret = 0;
+
+	switch ( v.Type() )
+	{
+	case dtAnd:
+		for ( DLVertex::const_iterator q = v.begin(), q_end = v.end(); q < q_end; ++q )
+			ret = std::max ( ret, gatherDeps ( createBiPointer(*q,posV), root, pos ) );
+		break;
+
+	case dtPSingleton:
+	case dtNSingleton:
+	case dtNConcept:
+	case dtPConcept:
+		if ( isNegative(p) && isPNameTag(v.Type()) )
+			break;
+		InProcess.insert(p);
+		ret = gatherDeps ( createBiPointer(v.getC(),posV), root, pos );
+		InProcess.erase(p);
+		break;
+
+	case dtForall:
+	case dtLE:
+	{
+		const TRole* R = v.getRole();
+		if ( R->isDataRole() || unlikely(R->isTop()) )
+			break;
+		BipolarPointer x = createBiPointer(v.getC(),posV);
+		if ( x != bpTOP )
+			ret = std::max ( ret, gatherPoint ( x, root, pos ) );
+		x = R->getBPRange();
+		if ( x != bpTOP )
+			ret = std::max ( ret, gatherPoint ( x, root, pos ) );
+		break;
+	}
+
+	default:	// no caches are needed for the rest
+		break;
+	}
+
+	DepLevels[p] = ret;
+	return ret;
+}
+
+/// gather a point P with its dependencies; @return 1 + its level (0 if it needs no cache)
+unsigned int
+ParallelCacheBuilder :: gatherPoint ( BipolarPointer p, const TConcept* root, bool pos )
+{
+	if ( tBox.DLHeap.getCache(p) != NULL || InProcess.find(p) != InProcess.end() || InGather.find(p) != InGather.end() )
+		return 0;
+	std::map<BipolarPointer, unsigned int>::const_iterator found = Known.find(p);
+	if ( found != Known.end() )
+		return found->second + 1;
+
+	// the caches of the entries met in the cascade go to the lower levels, so every point is checked
+	// with all the caches of its cascade; the cycles are broken by the names and the points being gathered
+	InGather.insert(p);
+	unsigned int level = gatherDeps ( p, root, pos );
+	InGather.erase(p);
+
+	Known[p] = level;
+	if ( Levels.size() <= level )
+		Levels.resize(level+1);
+	Levels[level].push_back(Points.size());
+	Points.push_back(CachePoint(p,root,pos));
+	return level + 1;
+}
+
+/// gather the positive or negative cache of the concept C
+void
+ParallelCacheBuilder :: addConcept ( const TConcept* C, bool pos )
+{
+	// nominal reasoner changes individuals, so such caches are built in the main thread
+	LogicFeatures lf;
+	if ( pos )
+		tBox.fillQueryFeatures ( lf, C, NULL );
+	else
+		tBox.fillQueryFeatures ( lf, NULL, C );
+	if ( lf.hasSingletons() )
+		return;
+
+	gatherPoint ( pos ? C->pName : inverse(C->pName), C, pos );
+}
+
+/// build the caches of the added concepts level by level; install them into the DAG
+void
+ParallelCacheBuilder :: run ( void )
+{
+	// the cascaded caching is switched off in the presence of the top role
+	if ( tBox.testHasTopRole() )
+		return;
+
+	// the caches the classification would build: the sat ones are not needed for the CD and EL-complete concepts
+	bool needNegative = false;
+	for ( std::vector<const TConcept*>::const_iterator p = Concepts.begin(), p_end = Concepts.end(); p != p_end; ++p )
+		if ( !(*p)->isSynonym() && (*p)->getClassTag() != cttTrueCompletelyDefined && !tBox.isELFComplete(*p) )
+		{
+			addConcept ( *p, /*pos=*/true );
+			needNegative = true;
+		}
+	// the sub ones are used only by the tests of the concepts that are not EL-complete
+	if ( needNegative )
+		for ( std::vector<const TConcept*>::const_iterator p = Concepts.begin(), p_end = Concepts.end(); p != p_end; ++p )
+			if ( !(*p)->isSynonym() )
+				addConcept ( *p, /*pos=*/false );
+
+	// reasoners check nominals via the current features of the TBox
+	LogicFeatures* oldFeature = tBox.curFeature;
+	tBox.curFeature = &NoNominals;
+
+	for ( std::vector<std::vector<unsigned int> >::const_iterator level = Levels.begin(), l_end = Levels.end(); level != l_end; ++level )
+	{
+		if ( tBox.isCancelled() )
+			break;
+
+		Batch = &*level;
+		Pool.run ( *this, Batch->size() );
+
+		for ( std::vector<unsigned int>::const_iterator i = Batch->begin(), i_end = Batch->end(); i != i_end; ++i )
+		{
+			CachePoint& point = Points[*i];
+			// the cache might be there already; it is set only once
+			if ( point.cache != NULL && tBox.DLHeap.getCache(point.bp) == NULL )
+			{
+				tBox.DLHeap.setCache ( point.bp, point.cache );
+				point.cache = NULL;
+				++nBuilt;
+			}
+			else if ( point.dropped )
+				++nDropped;
+		}
+	}
+
+	Batch = NULL;
+	tBox.curFeature = oldFeature;
+}
+
+void
+ParallelCacheBuilder :: process ( unsigned int worker, unsigned int item )
+{
+	CachePoint& point = Points[(*Batch)[item]];
+	DlSatTester* reasoner = Reasoners[worker];
+
+	try
+	{
+		// the test is made wrt the features of the concept whose cascade contains the point
+		LogicFeatures lf;
+		if ( point.pos )
+			tBox.fillQueryFeatures ( lf, point.root, NULL );
+		else
+			tBox.fillQueryFeatures ( lf, NULL, point.root );
+		reasoner->setBlockingMethod ( lf.hasInverseRole(), TBox::hasNR(lf) );
+		bool sat = reasoner->runSat(point.bp);
+		// the result of the cancelled test is meaningless
+		if ( !tBox.isCancelled() )
+			point.cache = reasoner->buildCacheByCGraph(sat);
+	}
+	catch(...)
+	{
+		// timeout or other problem: leave the cache to the main thread
+		point.dropped = true;
+	}
+}
@@ -0,0 +1,138 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef PARALLELCACHEBUILDER_H
+#define PARALLELCACHEBUILDER_H
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "tWorkerPool.h"
+#include "BiPointer.h"
+#include "LogicFeature.h"
+
+class TBox;
+class TConcept;
+class DlSatTester;
+class modelCacheInterface;
+
+/**
+ *	Builds the model caches of the named concepts before the classification
+ *	in a pool of threads. The DAG entries are gathered in the same way as
+ *	the cascaded caching does it, and every entry gets a level: the leaves
+ *	of the cascade are at level 0, the entry depending on the ones of the
+ *	level N is at level N+1. All the entries of a level are checked in parallel by
+ *	the per-thread reasoners; the caches are installed by the main thread
+ *	before the next level starts, so the upper levels could use them.
+ */
+class ParallelCacheBuilder: public TWorkerPool::Job
+{
+protected:	// types
+		/// DAG entry to build a cache for
+	struct CachePoint
+	{
+			/// DAG entry
+		BipolarPointer bp;
+			/// concept whose cascade contains the entry; defines the features of the test
+		const TConcept* root;
+			/// true iff the entry was reached from the positive ROOT
+		bool pos;
+			/// built cache; NULL if the test was not made
+		modelCacheInterface* cache;
+			/// true iff the worker failed to make the test (timeout or other problem)
+		bool dropped;
+			/// init c'tor
+		CachePoint ( BipolarPointer p, const TConcept* C, bool Pos ) : bp(p), root(C), pos(Pos), cache(NULL), dropped(false) {}
+	}; // CachePoint
+		/// all the points
+	typedef std::vector<CachePoint> PointVector;
+
+protected:	// members
+		/// host TBox
+	TBox& tBox;
+		/// pool of the worker threads
+	TWorkerPool Pool;
+		/// reasoner for every worker
+	std::vector<DlSatTester*> Reasoners;
+		/// concepts to be classified
+	std::vector<const TConcept*> Concepts;
+		/// all the gathered points
+	PointVector Points;
+		/// indices of the points for every level
+	std::vector<std::vector<unsigned int> > Levels;
+		/// map between the gathered DAG entries and their levels
+	std::map<BipolarPointer, unsigned int> Known;
+		/// results of gatherDeps() for the traversed DAG entries
+	std::map<BipolarPointer, unsigned int> DepLevels;
+		/// entries that are being gathered; used to find cycles
+	std::set<BipolarPointer> InProcess;
+		/// points whose dependencies are being gathered; used to find cycles through the fillers
+	std::set<BipolarPointer> InGather;
+		/// indices of the points of the currently processed level
+	const std::vector<unsigned int>* Batch;
+		/// features without nominals to be used by the TBox while a level is running
+	LogicFeatures NoNominals;
+		/// number of caches built in parallel
+	unsigned long nBuilt;
+		/// number of caches the workers failed to build; they are built by the main thread
+	unsigned long nDropped;
+
+private:	// no copy
+		/// no copy c'tor
+	ParallelCacheBuilder ( const ParallelCacheBuilder& );
+		/// no assignment
+	ParallelCacheBuilder& operator = ( const ParallelCacheBuilder& );
+
+protected:	// methods
+		/// gather the points the cache of P depends on; @return 1 + the max level of them (0 if there are none)
+	unsigned int gatherDeps ( BipolarPointer p, const TConcept* root, bool pos );
+		/// gather a point P with its dependencies; @return 1 + its level (0 if it needs no cache)
+	unsigned int gatherPoint ( BipolarPointer p, const TConcept* root, bool pos );
+		/// gather the positive or negative cache of the concept C
+	void addConcept ( const TConcept* C, bool pos );
+
+public:		// interface
+		/// c'tor: create NTHREADS workers for a given KB
+	ParallelCacheBuilder ( TBox& kb, unsigned int nThreads );
+		/// d'tor: stop all the workers, delete unused caches
+	virtual ~ParallelCacheBuilder ( void );
+
+		/// add the concepts [BEGIN,END) whose classification would use the caches
+	template<class Iterator>
+	void addConcepts ( Iterator begin, Iterator end )
+	{
+		for ( ; begin != end; ++begin )
+			Concepts.push_back(*begin);
+	}
+		/// build the caches of the added concepts level by level; install them into the DAG
+	void run ( void );
+
+		/// get number of the caches built in parallel
+	unsigned long getNBuilt ( void ) const { return nBuilt; }
+		/// get number of the caches the workers failed to build
+	unsigned long getNDropped ( void ) const { return nDropped; }
+		/// get number of the worker threads
+	unsigned int getNThreads ( void ) const { return Pool.size(); }
+
+		/// process a point number ITEM of the current level in the thread number WORKER
+	virtual void process ( unsigned int worker, unsigned int item );
+}; // ParallelCacheBuilder
+
+#endif
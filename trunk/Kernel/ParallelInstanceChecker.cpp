@@ -0,0 +1,120 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "ParallelInstanceChecker.h"
+#include "ReasonerNom.h"
+
+ParallelInstanceChecker :: ParallelInstanceChecker ( TBox& kb, const TABoxPartition& partition, const TConcept* query, unsigned int nThreads )
+	: tBox(kb)
+	, Partition(partition)
+	, Query(query)
+	, Pool(nThreads)
+	, nParallelTests(0)
+	, nDroppedTests(0)
+{
+}
+
+ParallelInstanceChecker :: ~ParallelInstanceChecker ( void )
+{
+	Pool.stop();
+	for ( std::vector<NominalReasoner*>::iterator p = Reasoners.begin(), p_end = Reasoners.end(); p != p_end; ++p )
+		delete *p;
+}
+
+void
+ParallelInstanceChecker :: addCandidate ( const TIndividual* i )
+{
+	Groups[Partition.getComponent(i)].push_back(Candidates.size());
+	Candidates.push_back(i);
+}
+
+void
+ParallelInstanceChecker :: run ( void )
+{
+	Results.assign ( Candidates.size(), -1 );
+
+	// individuals unknown to the partition are left to the main thread
+	Batch.clear();
+	for ( std::map<unsigned int, IndexVector>::iterator p = Groups.begin(), p_end = Groups.end(); p != p_end; ++p )
+		if ( p->first < Partition.size() )
+			Batch.push_back(std::make_pair ( p->first, &p->second ));
+
+	// there is no point to process a single component in a separate thread
+	if ( Batch.size() < 2 )
+		return;
+
+	// reasoners check nominals via the current features of the TBox
+	LogicFeatures* oldFeature = tBox.curFeature;
+	tBox.fillQueryFeatures ( Features, Candidates.front(), Query );
+	tBox.curFeature = &Features;
+
+	// reasoners are created here as their c'tors change the TBox
+	for ( unsigned int i = 0; i < Pool.size(); ++i )
+	{
+		NominalReasoner* reasoner = new NominalReasoner(tBox);
+		reasoner->setPartition(&Partition);
+		reasoner->setBlockingMethod ( tBox.isIRinQuery(), tBox.isNRinQuery() );
+		Reasoners.push_back(reasoner);
+	}
+
+	Pool.run ( *this, Batch.size() );
+	tBox.curFeature = oldFeature;
+
+	// workers re-used the nominal nodes of the individuals, so the cloud of the main reasoner is invalid now
+	static_cast<NominalReasoner*>(tBox.nomReasoner)->setPartition(&Partition);
+
+	for ( std::vector<int>::const_iterator p = Results.begin(), p_end = Results.end(); p != p_end; ++p )
+		if ( *p >= 0 )
+			++nParallelTests;
+		else if ( *p == -2 )
+			++nDroppedTests;
+}
+
+void
+ParallelInstanceChecker :: process ( unsigned int worker, unsigned int item )
+{
+	NominalReasoner* reasoner = Reasoners[worker];
+	const IndexVector& Group = *Batch[item].second;
+
+	try
+	{
+		// the component is known to be consistent; its model is the base of all the tests
+		std::set<unsigned int> comps;
+		comps.insert(Batch[item].first);
+		reasoner->initCloud(comps);
+		if ( !reasoner->checkNominalCloud() )
+			return;
+
+		for ( IndexVector::const_iterator p = Group.begin(), p_end = Group.end(); p != p_end; ++p )
+		{
+			bool result = !reasoner->runSat ( Candidates[*p]->resolveId(), inverse(Query->resolveId()) );
+			// the result of the cancelled test is meaningless
+			if ( tBox.isCancelled() )
+				return;
+			Results[*p] = result ? 1 : 0;
+		}
+	}
+	catch(...)
+	{
+		// timeout or other problem: leave the rest of the candidates to the main thread
+		for ( IndexVector::const_iterator p = Group.begin(), p_end = Group.end(); p != p_end; ++p )
+			if ( Results[*p] < 0 )
+				Results[*p] = -2;
+	}
+}
@@ -0,0 +1,106 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef PARALLELINSTANCECHECKER_H
+#define PARALLELINSTANCECHECKER_H
+
+#include <map>
+#include <vector>
+
+#include "tWorkerPool.h"
+#include "LogicFeature.h"
+
+class TBox;
+class TConcept;
+class TIndividual;
+class TABoxPartition;
+class NominalReasoner;
+
+/**
+ *	Checks whether the candidates of the instance retrieval are instances
+ *	of a query concept in a pool of threads. The candidates are grouped by
+ *	their ABox components; every component is processed by a single thread
+ *	that has its own nominal reasoner over the cloud of the component. The
+ *	nominal nodes of the individuals are changed by the workers, so the main
+ *	nominal reasoner rebuilds its cloud afterwards.
+ */
+class ParallelInstanceChecker: public TWorkerPool::Job
+{
+protected:	// types
+		/// indices of the candidates of a component
+	typedef std::vector<unsigned int> IndexVector;
+
+protected:	// members
+		/// host TBox
+	TBox& tBox;
+		/// components of the candidates
+	const TABoxPartition& Partition;
+		/// query concept
+	const TConcept* Query;
+		/// pool of the worker threads
+	TWorkerPool Pool;
+		/// reasoner for every worker
+	std::vector<NominalReasoner*> Reasoners;
+		/// all the candidates
+	std::vector<const TIndividual*> Candidates;
+		/// results of the tests: 1 if the candidate is an instance, 0 if not, -1 if unknown, -2 if the worker failed to make it
+	std::vector<int> Results;
+		/// candidates grouped by the components
+	std::map<unsigned int, IndexVector> Groups;
+		/// batch of the components to process
+	std::vector<std::pair<unsigned int, IndexVector*> > Batch;
+		/// features of the tests to be used by the TBox while the batch is running
+	LogicFeatures Features;
+		/// number of tests made in parallel
+	unsigned long nParallelTests;
+		/// number of tests the workers failed to make (timeout or other problem); they are re-done by the main thread
+	unsigned long nDroppedTests;
+
+private:	// no copy
+		/// no copy c'tor
+	ParallelInstanceChecker ( const ParallelInstanceChecker& );
+		/// no assignment
+	ParallelInstanceChecker& operator = ( const ParallelInstanceChecker& );
+
+public:		// interface
+		/// c'tor: create NTHREADS workers to check the instances of QUERY in the components of the PARTITION of a given KB
+	ParallelInstanceChecker ( TBox& kb, const TABoxPartition& partition, const TConcept* query, unsigned int nThreads );
+		/// d'tor: stop all the workers
+	virtual ~ParallelInstanceChecker ( void );
+
+		/// add the candidate I to the batch
+	void addCandidate ( const TIndividual* i );
+		/// check all the candidates; do nothing if they are all in one component
+	void run ( void );
+		/// get number of the candidates
+	unsigned int size ( void ) const { return Candidates.size(); }
+		/// get the candidate number I
+	const TIndividual* getCandidate ( unsigned int i ) const { return Candidates[i]; }
+		/// get the result of the test of the candidate number I: 1 if it is an instance, 0 if not, <0 if unknown
+	int getResult ( unsigned int i ) const { return Results[i]; }
+		/// get number of the tests that were run in parallel
+	unsigned long getNParallelTests ( void ) const { return nParallelTests; }
+		/// get number of the tests the workers failed to make
+	unsigned long getNDroppedTests ( void ) const { return nDroppedTests; }
+
+		/// check the candidates of a component number ITEM of the batch in the thread number WORKER
+	virtual void process ( unsigned int worker, unsigned int item );
+}; // ParallelInstanceChecker
+
+#endif
@@ -0,0 +1,111 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "ParallelSubTester.h"
+#include "Reasoner.h"
+
+ParallelSubTester :: ParallelSubTester ( TBox& kb, unsigned int nThreads )
+	: tBox(kb)
+	, Pool(nThreads)
+	, nParallelTests(0)
+	, nDroppedTests(0)
+{
+	// reasoners are created here as their c'tors change the TBox
+	for ( unsigned int i = 0; i < nThreads; ++i )
+		Reasoners.push_back(new DlSatTester(tBox));
+}
+
+ParallelSubTester :: ~ParallelSubTester ( void )
+{
+	Pool.stop();
+	for ( std::vector<DlSatTester*>::iterator p = Reasoners.begin(), p_end = Reasoners.end(); p != p_end; ++p )
+		delete *p;
+}
+
+bool
+ParallelSubTester :: canRunInParallel ( const TConcept* p, const TConcept* q ) const
+{
+	// nominal reasoner changes individuals, so such tests are made in the main thread
+	LogicFeatures lf;
+	tBox.fillQueryFeatures ( lf, p, q );
+	return !lf.hasSingletons();
+}
+
+void
+ParallelSubTester :: runBatch ( void )
+{
+	// there is no point to run a single test in a separate thread
+	if ( Batch.size() > 1 )
+	{
+		// reasoners check nominals via the current features of the TBox
+		LogicFeatures* oldFeature = tBox.curFeature;
+		tBox.curFeature = &NoNominals;
+		Pool.run ( *this, Batch.size() );
+		tBox.curFeature = oldFeature;
+
+		for ( TestVector::const_iterator p = Batch.begin(), p_end = Batch.end(); p != p_end; ++p )
+			if ( p->result >= 0 )	// test was successfully performed
+			{
+				Results[TestKey(p->p,p->q)] = (p->result != 0);
+				++nParallelTests;
+				if ( tBox.pCostProfile != NULL )
+					tBox.pCostProfile->add ( p->p->getName(), p->cost );
+			}
+			else if ( p->result == -2 )
+				++nDroppedTests;
+	}
+
+	Batch.clear();
+}
+
+bool
+ParallelSubTester :: getResult ( const TConcept* p, const TConcept* q, bool& result )
+{
+	ResultMap::iterator found = Results.find(TestKey(p,q));
+	if ( found == Results.end() )
+		return false;
+	result = found->second;
+	Results.erase(found);
+	return true;
+}
+
+void
+ParallelSubTester :: process ( unsigned int worker, unsigned int item )
+{
+	SubTest& test = Batch[item];
+	DlSatTester* reasoner = Reasoners[worker];
+
+	try
+	{
+		LogicFeatures lf;
+		tBox.fillQueryFeatures ( lf, test.p, test.q );
+		reasoner->setBlockingMethod ( lf.hasInverseRole(), TBox::hasNR(lf) );
+		TCostMeter meter;
+		meter.start ( reasoner->getNTactics(), reasoner->getNBranches() );
+		bool result = !reasoner->runSat ( test.p->resolveId(), inverse(test.q->resolveId()) );
+		test.cost = meter.finish ( reasoner->getNTactics(), reasoner->getNBranches() );
+		// the result of the cancelled test is meaningless
+		if ( !tBox.isCancelled() )
+			test.result = result ? 1 : 0;
+	}
+	catch(...)
+	{
+		// timeout or other problem: leave the test to the main thread
+		test.result = -2;
+	}
+}
@@ -0,0 +1,116 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PARALLELSUBTESTER_H
+#define PARALLELSUBTESTER_H
+
+#include <map>
+#include <vector>
+
+#include "tWorkerPool.h"
+#include "LogicFeature.h"
+#include "tCostProfile.h"
+
+class TBox;
+class TConcept;
+class DlSatTester;
+
+/**
+ *	Runs a batch of SUB(P,Q) tests in a pool of threads. Every thread has
+ *	its own tableau reasoner working over the shared (read-only) DAG of
+ *	the TBox. Only the tests that do not require the nominal reasoner are
+ *	run in parallel. All the taxonomy changes are done by the caller; the
+ *	results are stored until they are requested by the caller.
+ */
+class ParallelSubTester: public TWorkerPool::Job
+{
+protected:	// types
+		/// single subsumption test
+	struct SubTest
+	{
+			/// subsumee
+		const TConcept* p;
+			/// subsumer
+		const TConcept* q;
+			/// result of the test: 1 if holds, 0 if not, -1 if unknown, -2 if the worker failed to make it
+		int result;
+			/// cost of the test
+		TCostRecord cost;
+			/// init c'tor
+		SubTest ( const TConcept* P, const TConcept* Q ) : p(P), q(Q), result(-1) {}
+	}; // SubTest
+		/// batch of tests
+	typedef std::vector<SubTest> TestVector;
+		/// key for the known results
+	typedef std::pair<const TConcept*, const TConcept*> TestKey;
+		/// map for the known results
+	typedef std::map<TestKey, bool> ResultMap;
+
+protected:	// members
+		/// host TBox
+	TBox& tBox;
+		/// pool of the worker threads
+	TWorkerPool Pool;
+		/// reasoner for every worker
+	std::vector<DlSatTester*> Reasoners;
+		/// current batch of tests
+	TestVector Batch;
+		/// results of the tests that were run but not requested yet
+	ResultMap Results;
+		/// features without nominals to be used by the TBox while the batch is running
+	LogicFeatures NoNominals;
+		/// number of tests made in parallel
+	unsigned long nParallelTests;
+		/// number of tests the workers failed to make (timeout or other problem); they are re-done by the main thread
+	unsigned long nDroppedTests;
+
+private:	// no copy
+		/// no copy c'tor
+	ParallelSubTester ( const ParallelSubTester& );
+		/// no assignment
+	ParallelSubTester& operator = ( const ParallelSubTester& );
+
+public:		// interface
+		/// c'tor: create NTHREADS workers for a given KB
+	ParallelSubTester ( TBox& kb, unsigned int nThreads );
+		/// d'tor: stop all the workers
+	virtual ~ParallelSubTester ( void );
+
+		/// @return true iff the SUB(P,Q) test could be done in a worker thread
+	bool canRunInParallel ( const TConcept* p, const TConcept* q ) const;
+		/// add the SUB(P,Q) test to the current batch
+	void addTest ( const TConcept* p, const TConcept* q ) { Batch.push_back(SubTest(p,q)); }
+		/// run all the tests from the current batch; save the known results
+	void runBatch ( void );
+		/// check whether the SUB(P,Q) result is known; if so, put it to RESULT and forget it
+	bool getResult ( const TConcept* p, const TConcept* q, bool& result );
+		/// forget all the tests and results
+	void clear ( void ) { Batch.clear(); Results.clear(); }
+
+		/// get number of the tests that were run in parallel
+	unsigned long getNParallelTests ( void ) const { return nParallelTests; }
+		/// get number of the tests the workers failed to make
+	unsigned long getNDroppedTests ( void ) const { return nDroppedTests; }
+		/// get number of the worker threads
+	unsigned int getNThreads ( void ) const { return Pool.size(); }
+
+		/// process a test number ITEM in the thread number WORKER
+	virtual void process ( unsigned int worker, unsigned int item );
+}; // ParallelSubTester
+
+#endif
@@ -45,17 +45,26 @@ DlSatTester :: DlSatTester ( TBox& tbox )
 	, bContext(NULL)
 	, tryLevel(InitBranchingLevelValue)
 	, nonDetShift(0)
+	, keptModel(bpINVALID)
+	, keptModelLevel(0)
+	, lastSubsumee(bpINVALID)
+	, nAllTactics(0)
+	, nAllBranches(0)
 	, curNode(NULL)
 	, dagSize(0)
 {
 	// init static part of CTree
-	CGraph.initContext ( tBox.nSkipBeforeBlock, tBox.useLazyBlocking, tBox.useAnywhereBlocking );
+	CGraph.initContext ( tBox.nSkipBeforeBlock, tBox.useLazyBlocking, tBox.useAnywhereBlocking, tBox.maxKeptGraphSize );
 	// init datatype reasoner
 	tBox.getDataTypeCenter().initDataTypeReasoner(DTReasoner);
 	// init set of reflexive roles
 	tBox.getORM()->fillReflexiveRoles(ReflexiveRoles);
 	// init blocking statistics
 	clearBlockingStat();
+	// nogoods rely on the precise clash-sets
+	Nogoods.setCapacity ( tBox.useBackjumping ? tBox.nogoodStoreSize : 0 );
+	// init ties of the adaptive OR ordering
+	OrActivity.setSeed ( DLHeap.getOrSortSeed() );
 
 	resetSessionFlags();
 }
@@ -75,6 +84,7 @@ DlSatTester :: prepareReasoner ( void )
 	curNode = NULL;
 	bContext = NULL;
 	tryLevel = InitBranchingLevelValue;
+	keptModel = bpINVALID;
 
 	// clear last session information
 	resetSessionFlags();
@@ -106,16 +116,47 @@ DlSatTester :: findConceptClash ( const CWDArray& lab, BipolarPointer p, const D
 
 	incStat(nLookups);
 
-	for ( const_label_iterator i = lab.begin(), i_end = lab.end(); i < i_end; ++i )
-		if ( i->bp() == p )
+	const ConceptWDep* C = lab.get(p);
+	if ( C == NULL )	// we are able to insert a concept
+		return false;
+
+	// create clashSet
+	clashSet = C->getDep();
+	clashSet.add(dep);
+	return true;
+}
+
+bool
+DlSatTester :: isNogood ( const DlCompletionTree* node, BipolarPointer C, DepSet& dep )
+{
+	if ( !Nogoods.isActive() )
+		return false;
+	TNogoodStore::EntryRange range = Nogoods.getNogoods ( node->getId(), C );
+	for ( TNogoodStore::entry_iterator q = range.first; q != range.second; ++q )
+	{
+		DepSet reason;
+		bool holds = true;
+		for ( TNogoodStore::const_iterator p = Nogoods.begin(q->second), p_end = Nogoods.end(q->second); holds && p != p_end; ++p )
+			if ( p->Node != node->getId() || p->C != C )
+			{	// all the other facts of the nogood should be in the graph
+				const DlCompletionTree* n = CGraph.getNode(p->Node);
+				const ConceptWDep* fact = ( n == NULL || n->isPBlocked() ) ? NULL : n->label().getLabel(DLHeap[p->C].Type()).get(p->C);
+				if ( fact == NULL )
+				{
+					Nogoods.setFirstFact ( q->second, p );
+					holds = false;
+				}
+				else
+					reason.add(fact->getDep());
+			}
+		if ( holds )
 		{
-			// create clashSet
-			clashSet = i->getDep();
-			clashSet.add(dep);
+			incStat(nNogoodPrunes);
+			dep.add(reason);
 			return true;
 		}
+	}
 
-	// we are able to insert a concept
 	return false;
 }
 
@@ -394,6 +435,10 @@ DlSatTester :: hasDataClash ( const DlCompletionTree* Node )
 
 bool DlSatTester :: runSat ( void )
 {
+	// a test outside of the KB processing is a separate operation
+	TOperationGuard guard(tBox.getOperationControl());
+	// the previous test might be interrupted by an exception, so the timer is reset here
+	testTimer.Reset();
 	testTimer.Start();
 	bool result = checkSatisfiability ();
 	testTimer.Stop();
@@ -418,6 +463,9 @@ DlSatTester :: finaliseStatistic ( void )
 	// add the integer stat values
 	nNodeSaves.set(CGraph.getNNodeSaves());
 	nNodeRestores.set(CGraph.getNNodeRestores());
+	nBlockerSearches.set(CGraph.getNBlockerSearches());
+	nBlockerTests.set(CGraph.getNBlockerTests());
+	nNogoodsLearned.set(Nogoods.getNLearned());
 
 	// log statistics data
 	if ( LLM.isWritable(llRStat) )
@@ -475,6 +523,7 @@ bool DlSatTester :: checkSatisfiability ( void )
 			loop = 0;
 			if ( tBox.isCancelled() )
 				return false;
+			tBox.checkInterrupt();
 			if ( unlikely(getSatTimeout()) && 1000*(float)testTimer >= getSatTimeout() )
 				throw EFPPTimeout();
 		}
@@ -614,6 +663,20 @@ void DlSatTester :: restoreBC ( void )
 	bContext->nextOption();
 }
 
+void DlSatTester :: keepModel ( BipolarPointer p )
+{
+	keptModel = bpINVALID;
+	if ( !canKeepModel() )
+		return;
+
+	// put the model behind the barrier, as the nominal reasoner does with the nominal cloud
+	curNode = NULL;
+	createBCBarrier();
+	save();
+	keptModel = p;
+	keptModelLevel = getCurLevel()-1;
+}
+
 void DlSatTester :: save ( void )
 {
 	// save tree
@@ -629,6 +692,10 @@ void DlSatTester :: save ( void )
 	// init BC
 	clearBC();
 
+	// new branching operation would register its choices
+	if ( Nogoods.isActive() )
+		Nogoods.startDecision(getCurLevel()-1);
+
 	incStat(nStateSaves);
 
 	if ( LLM.isWritable(llSRState) )
@@ -657,6 +724,10 @@ void DlSatTester :: restore ( unsigned int newTryLevel )
 	// restore tree
 	CGraph.restore(getCurLevel());
 
+	// forget nogoods about the removed nodes
+	if ( Nogoods.isActive() )
+		Nogoods.restore ( CGraph.end() - CGraph.begin() );
+
 	// restore TODO list
 	TODO.restore(getCurLevel());
 
@@ -736,6 +807,11 @@ void DlSatTester :: logStatisticData ( std::ostream& o, bool needLocal ) const
 	nNodeSaves.Print		( o, needLocal, "\nThere were made ", " save(s) of tree state" );
 	nNodeRestores.Print		( o, needLocal, "\nThere were made ", " restore(s) of tree state" );
 	nLookups.Print			( o, needLocal, "\nThere were made ", " concept lookups" );
+	nBlockerSearches.Print	( o, needLocal, "\nThere were made ", " anywhere blocker searches" );
+	nBlockerTests.Print		( o, needLocal, "\n       checking ", " candidate blocker nodes" );
+	nNogoodsLearned.Print	( o, needLocal, "\nThere were learned ", " nogoods" );
+	nNogoodPrunes.Print		( o, needLocal, "\n     that pruned ", " branching choices" );
+	nKeptModelTests.Print	( o, needLocal, "\nThere were made ", " subsumption tests over the kept model" );
 #ifdef RKG_USE_FAIRNESS
 	nFairnessViolations.Print	( o, needLocal, "\nThere were ", " fairness constraints violation" );
 #endif
@@ -752,6 +828,57 @@ void DlSatTester :: logStatisticData ( std::ostream& o, bool needLocal ) const
 		o << "\nThe maximal graph size is " << CGraph.maxSize() << " nodes";
 }
 
+void
+DlSatTester :: getTotalStatistic ( std::map<std::string, unsigned long>& values ) const
+{
+#ifdef USE_REASONING_STATISTICS
+	AccumulatedStatistic::accumulateAll();	// ensure that the last reasoning results are in
+#	define ADD_STAT(name) values[#name] += name.get(/*needLocal=*/false)
+	ADD_STAT(nTacticCalls);
+	ADD_STAT(nUseless);
+	ADD_STAT(nIdCalls);
+	ADD_STAT(nSingletonCalls);
+	ADD_STAT(nOrCalls);
+	ADD_STAT(nOrBrCalls);
+	ADD_STAT(nAndCalls);
+	ADD_STAT(nSomeCalls);
+	ADD_STAT(nAllCalls);
+	ADD_STAT(nFuncCalls);
+	ADD_STAT(nLeCalls);
+	ADD_STAT(nGeCalls);
+	ADD_STAT(nNNCalls);
+	ADD_STAT(nMergeCalls);
+	ADD_STAT(nAutoEmptyLookups);
+	ADD_STAT(nAutoTransLookups);
+	ADD_STAT(nSRuleAdd);
+	ADD_STAT(nSRuleFire);
+	ADD_STAT(nStateSaves);
+	ADD_STAT(nStateRestores);
+	ADD_STAT(nNodeSaves);
+	ADD_STAT(nNodeRestores);
+	ADD_STAT(nLookups);
+	ADD_STAT(nBlockerSearches);
+	ADD_STAT(nBlockerTests);
+	ADD_STAT(nNogoodsLearned);
+	ADD_STAT(nNogoodPrunes);
+	ADD_STAT(nKeptModelTests);
+	ADD_STAT(nFairnessViolations);
+	ADD_STAT(nCacheTry);
+	ADD_STAT(nCacheFailedNoCache);
+	ADD_STAT(nCacheFailedShallow);
+	ADD_STAT(nCacheFailed);
+	ADD_STAT(nCachedSat);
+	ADD_STAT(nCachedUnsat);
+#	undef ADD_STAT
+#endif
+	// these are gathered regardless of the statistics build
+	values["nAllTactics"] += nAllTactics;
+	values["nAllBranches"] += nAllBranches;
+	unsigned long& maxSize = values["maxGraphSize"];
+	if ( maxSize < CGraph.maxSize() )
+		maxSize = CGraph.maxSize();
+}
+
 float
 DlSatTester :: printReasoningTime ( std::ostream& o ) const
 {
@@ -30,6 +30,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "DataReasoning.h"
 #include "ToDoList.h"
 #include "tFastSet.h"
+#include "tNogoodStore.h"
+#include "tConceptActivity.h"
 
 #ifdef _USE_LOGGING	// don't gather statistics w/o logging
 #	define USE_REASONING_STATISTICS
@@ -241,8 +243,9 @@ protected:	// members
 	TsProcTimer satTimer;
 		/// timer for the SUB tests (ie, general subsumption)
 	TsProcTimer subTimer;
-		/// timer for a single test; use it as a timeout checker
-	TsProcTimer testTimer;
+		/// timer for a single test; use it as a timeout checker. It counts the time of the running thread only,
+		/// as the reasoners of the worker threads check their timeouts concurrently
+	TsThreadTimer testTimer;
 
 	// save/restore option
 
@@ -256,6 +259,22 @@ protected:	// members
 	unsigned int nonDetShift;
 		/// last level when split rules were applied
 	unsigned int splitRuleLevel;
+		/// nogoods learned from the clash-sets of the current test
+	TNogoodStore Nogoods;
+		/// activity of the disjuncts in clashes for the adaptive OR ordering; kept between the tests
+	TConceptActivity OrActivity;
+		/// entry whose model is kept behind the barrier for the subsumption tests; bpINVALID if there is none
+	BipolarPointer keptModel;
+		/// level of the barrier in front of the kept model
+	unsigned int keptModelLevel;
+		/// entries whose kept models were abandoned as a test needed another choice inside the model
+	std::set<BipolarPointer> failedModels;
+		/// subsumee of the last subsumption test
+	BipolarPointer lastSubsumee;
+		/// number of tactic calls made by the reasoner (for the cost profiles)
+	unsigned long nAllTactics;
+		/// number of branching points made by the reasoner (for the cost profiles)
+	unsigned long nAllBranches;
 
 	// statistic elements
 
@@ -291,6 +310,14 @@ protected:	// members
 
 		nLookups,
 
+		nBlockerSearches,
+		nBlockerTests,
+
+		nNogoodsLearned,
+		nNogoodPrunes,
+
+		nKeptModelTests,
+
 		nFairnessViolations,
 
 		// reasoning cache
@@ -679,15 +706,15 @@ protected:	// methods
 	void clearBC ( void ) { bContext = NULL; }
 
 		/// create BC for Or rule
-	void createBCOr ( void ) { bContext = Stack.pushOr(); initBC(); }
+	void createBCOr ( void ) { bContext = Stack.pushOr(); initBC(); ++nAllBranches; }
 		/// create BC for NN-rule
-	void createBCNN ( void ) { bContext = Stack.pushNN(); initBC(); }
+	void createBCNN ( void ) { bContext = Stack.pushNN(); initBC(); ++nAllBranches; }
 		/// create BC for LE-rule
-	void createBCLE ( void ) { bContext = Stack.pushLE(); initBC(); }
+	void createBCLE ( void ) { bContext = Stack.pushLE(); initBC(); ++nAllBranches; }
 		/// create BC for LE-rule
-	void createBCTopLE ( void ) { bContext = Stack.pushTopLE(); initBC(); }
+	void createBCTopLE ( void ) { bContext = Stack.pushTopLE(); initBC(); ++nAllBranches; }
 		/// create BC for Choose-rule
-	void createBCCh ( void ) { bContext = Stack.pushCh(); initBC(); }
+	void createBCCh ( void ) { bContext = Stack.pushCh(); initBC(); ++nAllBranches; }
 		/// create BC for the barrier
 	void createBCBarrier ( void ) { bContext = Stack.pushBarrier(); initBC(); }
 
@@ -697,6 +724,8 @@ protected:	// methods
 	bool planOrProcessing ( const DLVertex& cur, DepSet& dep );
 		/// aux method for disjunction processing
 	bool processOrEntry ( void );
+		/// order the applicable OR entries wrt the activity of the disjuncts in clashes
+	void sortOrConceptsToTest ( void );
 
 	// support for (qualified) number restrictions
 
@@ -886,6 +915,10 @@ protected:	// methods
 			getCurLevel();
 #		endif
 	}
+		/// @return true iff the model of a SAT test could be kept for the subsumption tests
+	bool canKeepModel ( void ) const { return tBox.useIncrementalSubsumption && tBox.useBackjumping && !hasNominals(); }
+		/// keep the model of P built by the last SAT test behind a barrier for the subsumption tests
+	void keepModel ( BipolarPointer p );
 		/// save current reasoning state
 	void save ( void );
 		/// restore reasoning state to the latest saved position
@@ -918,6 +951,14 @@ protected:	// methods
 	const DepSet& getBranchDep ( void ) const { return bContext->branchDep; }
 		/// update cumulative branch-dep with current clash-set
 	void updateBranchDep ( void ) { getBranchDep().add(getClashSet()); }
+		/// register that the current branching operation adds C to NODE
+	void addDecisionFact ( const DlCompletionTree* node, BipolarPointer C )
+	{
+		if ( Nogoods.isActive() )
+			Nogoods.addDecisionFact ( getCurLevel()-1, node->getId(), C );
+	}
+		/// check whether adding C to NODE is known to fail; if so, add the reasons of the failure to DEP
+	bool isNogood ( const DlCompletionTree* node, BipolarPointer C, DepSet& dep );
 		/// prepare cumulative dep-set to usage
 	void prepareBranchDep ( void ) { getBranchDep().restrict(getCurLevel()); }
 		/// prepare cumulative dep-set and copy itto general clash-set
@@ -966,6 +1007,14 @@ public:
 	virtual void prepareReasoner ( void );
 		/// set-up satisfiability task for given pointers and run runSat on it
 	bool runSat ( BipolarPointer p, BipolarPointer q = bpTOP );
+		/// run SAT test for P and Q over the kept model of P; build and keep the model if necessary
+	bool runSatOverModel ( BipolarPointer p, BipolarPointer q );
+		/// forget the kept model (eg, if the DAG entries it was built for are removed)
+	void dropKeptModel ( void )
+	{
+		keptModel = lastSubsumee = bpINVALID;
+		failedModels.clear();
+	}
 		/// set-up role disjointness task for given roles and run SAT test
 	bool checkDisjointRoles ( const TRole* R, const TRole* S );
 		/// set-up role irreflexivity task for R and run SAT test
@@ -975,7 +1024,13 @@ public:
 	const DlCompletionTree* getRootNode ( void ) const { return CGraph.getRoot(); }
 
 		/// set blocking method for a session
-	void setBlockingMethod ( bool hasInverse, bool hasQCR ) { CGraph.setBlockingMethod ( hasInverse, hasQCR ); }
+	void setBlockingMethod ( bool hasInverse, bool hasQCR )
+	{
+		// the kept model is valid only for the blocking method it was built with
+		if ( !CGraph.isBlockingMethod ( hasInverse, hasQCR ) )
+			dropKeptModel();
+		CGraph.setBlockingMethod ( hasInverse, hasQCR );
+	}
 
 		/// build cache entry for given DAG node, using cascaded schema; @return cache
 	const modelCacheInterface* createCache ( BipolarPointer p );
@@ -998,6 +1053,12 @@ public:
 		clearBlockingStat();
 		o << "\n";
 	}
+		/// add the total values of the reasoning statistic to VALUES; the values are indexed by the counter names
+	void getTotalStatistic ( std::map<std::string, unsigned long>& values ) const;
+		/// get the number of tactic calls made by the reasoner
+	unsigned long getNTactics ( void ) const { return nAllTactics; }
+		/// get the number of branching points made by the reasoner
+	unsigned long getNBranches ( void ) const { return nAllBranches; }
 
 		/// print SAT/SUB timings to O; @return total time spend during reasoning
 	float printReasoningTime ( std::ostream& o ) const;
@@ -1016,6 +1077,7 @@ inline void DlSatTester :: resetSessionFlags ( void )
 	encounterNominal = false;
 	checkDataNode = true;
 	splitRuleLevel = 0;
+	Nogoods.clear();
 }
 
 inline bool
@@ -1055,6 +1117,50 @@ DlSatTester :: runSat ( BipolarPointer p, BipolarPointer q )
 	timer.Start();
 	bool result = runSat();
 	timer.Stop();
+	// the model of P alone could be reused by the subsumption tests
+	if ( result && q == bpTOP )
+		keepModel(p);
+	return result;
+}
+
+inline bool
+DlSatTester :: runSatOverModel ( BipolarPointer p, BipolarPointer q )
+{
+	if ( !canKeepModel() )
+		return runSat ( p, q );
+
+	if ( keptModel != p )
+	{
+		// build the model only for a series of tests with the same P (eg, top-down search)
+		bool series = lastSubsumee == p;
+		lastSubsumee = p;
+		if ( !series || failedModels.find(p) != failedModels.end() )
+			return runSat ( p, q );
+		// build the model of P; the SAT test keeps it
+		if ( !runSat(p) )
+			return false;
+	}
+	lastSubsumee = p;
+
+	// return to the model of P and add Q to it
+	restore(keptModelLevel);
+	save();
+	resetSessionFlags();
+	incStat(nKeptModelTests);
+
+	bool result = false;
+	subTimer.Start();
+	if ( !addToDoEntry ( CGraph.getRoot(), ConceptWDep(q) ) || !tunedRestore() )
+		result = runSat();
+	subTimer.Stop();
+
+	// Q can't be added to another choice inside the model: make the usual test
+	if ( unlikely ( keptModel == bpINVALID ) )
+	{
+		failedModels.insert(p);
+		return runSat ( p, q );
+	}
+
 	return result;
 }
 
@@ -1114,6 +1220,17 @@ inline bool DlSatTester :: backJumpedRestore ( void )
 	if ( getClashSet().empty () )
 		return true;
 
+	// the choice inside the kept model is wrong: the test over the model fails
+	if ( unlikely ( keptModel != bpINVALID && getClashSet().level() < keptModelLevel ) )
+	{
+		keptModel = bpINVALID;
+		return true;
+	}
+
+	// remember the choices that lead to the clash
+	if ( Nogoods.isActive() )
+		Nogoods.learn(getClashSet());
+
 	// some non-deterministic choices were done
 	restore ( getClashSet().level() );
 	return false;
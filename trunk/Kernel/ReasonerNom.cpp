@@ -33,6 +33,26 @@ NominalReasoner :: initNominalVector ( void )
 			Nominals.push_back(*pi);
 }
 
+/// drop the current cloud and make the new one of the components COMPS (the whole ABox if there is no partition)
+void
+NominalReasoner :: initCloud ( const std::set<unsigned int>& comps )
+{
+	// drop the previous cloud together with its barrier
+	DlSatTester::prepareReasoner();
+	nonDetShift = 0;
+
+	if ( Partition == NULL )
+	{
+		initNominalVector();
+		return;
+	}
+
+	CloudComponents = comps;
+	Nominals.clear();
+	for ( std::set<unsigned int>::const_iterator p = comps.begin(), p_end = comps.end(); p != p_end; ++p )
+		Nominals.insert ( Nominals.end(), (*Partition)[*p].Individuals.begin(), (*Partition)[*p].Individuals.end() );
+}
+
 /// prerpare Nominal Reasoner to a new job
 void
 NominalReasoner :: prepareReasoner ( void )
@@ -58,7 +78,7 @@ NominalReasoner :: prepareReasoner ( void )
 }
 
 bool
-NominalReasoner :: consistentNominalCloud ( void )
+NominalReasoner :: checkNominalCloud ( void )
 {
 	if ( LLM.isWritable(llBegSat) )
 		LL << "\n--------------------------------------------\n"
@@ -90,7 +110,13 @@ NominalReasoner :: consistentNominalCloud ( void )
 	if ( LLM.isWritable(llSatResult) )
 		LL << "\nThe ontology is " << (result ? "consistent" : "INCONSISTENT");
 
-	if ( !result )
+	return result;
+}
+
+bool
+NominalReasoner :: consistentNominalCloud ( void )
+{
+	if ( !checkNominalCloud() )
 		return false;
 
 	// ABox is consistent -> create cache for every nominal in KB
@@ -110,9 +136,17 @@ NominalReasoner :: initNominalCloud ( void )
 			return true;	// ABox is inconsistent
 
 	// create edges between related nodes
-	for ( TBox::RelatedCollection::const_iterator q = tBox.RelatedI.begin(); q != tBox.RelatedI.end(); ++q, ++q )
-		if ( initRelatedNominals(*q) )
-			return true;	// ABox is inconsistent
+	if ( Partition == NULL )
+	{
+		for ( TBox::RelatedCollection::const_iterator q = tBox.RelatedI.begin(); q != tBox.RelatedI.end(); ++q, ++q )
+			if ( initRelatedNominals(*q) )
+				return true;	// ABox is inconsistent
+	}
+	else	// only the edges of the cloud's components
+		for ( std::set<unsigned int>::const_iterator c = CloudComponents.begin(), c_end = CloudComponents.end(); c != c_end; ++c )
+			for ( TABoxPartition::RelatedVector::const_iterator q = (*Partition)[*c].Related.begin(), q_end = (*Partition)[*c].Related.end(); q != q_end; ++q )
+				if ( initRelatedNominals(*q) )
+					return true;	// ABox is inconsistent
 
 	// create disjoint markers on nominal nodes
 	if ( tBox.Different.empty() )
@@ -125,7 +159,7 @@ NominalReasoner :: initNominalCloud ( void )
 	{
 		CGraph.initIR();
 		for ( SingletonVector::const_iterator p = r->begin(); p != r->end(); ++p )
-			if ( CGraph.setCurIR ( resolveSynonym(*p)->node, dummy ) )	// different(c,c)
+			if ( inCloud(*p) && CGraph.setCurIR ( resolveSynonym(*p)->node, dummy ) )	// different(c,c)
 				return true;
 		CGraph.finiIR();
 	}
@@ -19,7 +19,11 @@ Foundation, 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
 #ifndef REASONERNOM_H
 #define REASONERNOM_H
 
+#include <set>
+#include <algorithm>
+
 #include "Reasoner.h"
+#include "tABoxPartition.h"
 
 class NominalReasoner: public DlSatTester
 {
@@ -28,8 +32,12 @@ protected:	// type definition
 	typedef TBox::SingletonVector SingletonVector;
 
 protected:	// members
-		/// all nominals defined in TBox
+		/// all nominals of the current nominal cloud
 	SingletonVector Nominals;
+		/// ABox partition; NULL if the cloud contains all the individuals
+	const TABoxPartition* Partition;
+		/// components of the partition in the current cloud
+	std::set<unsigned int> CloudComponents;
 
 protected:	// methods
 		/// prepare reasoning
@@ -43,10 +51,16 @@ protected:	// methods
 
 		/// init vector of nominals defined in TBox
 	void initNominalVector ( void );
+		/// @return true iff the individual P is in the current cloud
+	bool inCloud ( const TIndividual* p ) const
+		{ return Partition == NULL || CloudComponents.count(Partition->getComponent(resolveSynonym(p))) > 0; }
 
-		/// create cache entry for given singleton
+		/// create cache entry for given singleton; the cache is set only once
 	void registerNominalCache ( TIndividual* p )
-		{ DLHeap.setCache ( p->pName, createModelCache(p->node->resolvePBlocker()) ); }
+	{
+		if ( DLHeap.getCache(p->pName) == NULL )
+			DLHeap.setCache ( p->pName, createModelCache(p->node->resolvePBlocker()) );
+	}
 		/// init single nominal node
 	bool initNominalNode ( const TIndividual* nom )
 	{
@@ -63,29 +77,57 @@ protected:	// methods
 	void updateClassifiedSingleton ( TIndividual* p )
 	{
 		registerNominalCache(p);
-		if ( unlikely(p->node->isPBlocked()) )
-		{
-			// BP of the individual P is merged to
-			BipolarPointer bp = p->node->getBlocker()->label().begin_sc()->bp();
-			TIndividual* blocker = (TIndividual*)DLHeap[bp].getConcept();
-			fpp_assert ( blocker->node == p->node->getBlocker() );
-			tBox.SameI[p] = std::make_pair ( blocker, p->node->getPurgeDep().empty() );
-		}
+		bool det;
+		TIndividual* blocker = getMergedIndividual ( p, det );
+		if ( unlikely(blocker != NULL) )
+			tBox.SameI[p] = std::make_pair ( blocker, det );
 	}
 
 public:
 		/// c'tor
 	NominalReasoner ( TBox& tbox )
 		: DlSatTester(tbox)
+		, Partition(NULL)
 	{
 		initNominalVector();
 	}
 		/// empty d'tor
 	virtual ~NominalReasoner ( void ) {}
 
-		/// check whether ontology with nominals is consistent
+		/// check whether the current nominal cloud is consistent; keep its model below the barrier
+	bool checkNominalCloud ( void );
+		/// check whether ontology with nominals is consistent; create caches for the nominals
 	bool consistentNominalCloud ( void );
 
+		/// set the ABox partition P to build the clouds from its components; NULL means the whole ABox
+	void setPartition ( const TABoxPartition* p )
+	{
+		Partition = p;
+		CloudComponents.clear();
+	}
+		/// @return true iff there is a cloud to reason over
+	bool hasCloud ( void ) const { return Partition == NULL || !CloudComponents.empty(); }
+		/// @return true iff the current cloud contains all the components COMPS
+	bool hasComponents ( const std::set<unsigned int>& comps ) const
+		{ return std::includes ( CloudComponents.begin(), CloudComponents.end(), comps.begin(), comps.end() ); }
+		/// drop the current cloud and make the new one of the components COMPS (the whole ABox if there is no partition)
+	void initCloud ( const std::set<unsigned int>& comps );
+		/// @return pseudo-model cache of the individual P of the current cloud
+	modelCacheInterface* buildNominalCache ( const TIndividual* p ) const
+		{ return createModelCache(p->node->resolvePBlocker()); }
+		/// @return individual the nominal P is merged to in the current cloud (NULL if none); set DET iff the merge is deterministic
+	TIndividual* getMergedIndividual ( const TIndividual* p, bool& det ) const
+	{
+		if ( likely(!p->node->isPBlocked()) )
+			return NULL;
+		// BP of the individual P is merged to
+		BipolarPointer bp = p->node->getBlocker()->label().begin_sc()->bp();
+		TIndividual* blocker = (TIndividual*)DLHeap[bp].getConcept();
+		fpp_assert ( blocker->node == p->node->getBlocker() );
+		det = p->node->getPurgeDep().empty();
+		return blocker;
+	}
+
 		/// check an extra conditions (for query answering)
 	bool checkExtraCond ( void );
 }; // NominalReasoner
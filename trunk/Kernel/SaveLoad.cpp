@@ -24,46 +24,11 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "ReasonerNom.h"	// for initReasoner()
 #include "SaveLoadManager.h"
 
-const char* ReasoningKernel :: InternalStateFileHeader = "FaCT++InternalStateDump1.0";
+const char* ReasoningKernel :: InternalStateFileHeader = "FaCT++InternalStateDump2.0";
 
-const int bytesInInt = sizeof(int);
-
-#if 0
-// FIXME!! try to avoid recursion later on
-static inline
-void saveUIntAux ( ostream& o, unsigned int n, const int rest )
-{
-	if ( rest > 1 )
-		saveUIntAux ( o, n/256, rest-1 );
-	m.o() << (unsigned char)n%256;
-}
-
-static inline
-void saveUInt ( ostream& o, unsigned int n )
-{
-	saveUIntAux ( o, n, bytesInInt );
-}
-
-static inline
-void saveSInt ( ostream& o, int n ) { saveUInt(o,n); }
-
-static inline
-unsigned int loadUInt ( istream& i )
-{
-	static unsigned int ret = 0;
-	unsigned char byte;
-	for ( int j = bytesInInt-1; j >= 0; --j )
-	{
-		i >> byte;
-		ret *= 256;
-		ret += byte;
-	}
-	return ret;
-}
-
-static inline
-int loadSInt ( istream& i ) { return (int)loadUInt(i); }
-#endif	// 0
+const unsigned int bytesInInt = sizeof(int);
+/// value to check the byte order of the saved integers
+const unsigned int byteOrderMark = 0x01020304;
 
 //----------------------------------------------------------
 //-- Implementation of the Kernel methods (Kernel.h)
@@ -127,24 +92,25 @@ ReasoningKernel :: Load ( void )
 void
 ReasoningKernel :: SaveHeader ( SaveLoadManager& m ) const
 {
-	m.o() << InternalStateFileHeader << "\n" << Version << "\n" << bytesInInt << "\n";
+	m.saveTag(InternalStateFileHeader);
+	m.saveString(Version);
+	m.saveUInt(bytesInInt);
+	m.saveUInt(byteOrderMark);
 }
 
 void
 ReasoningKernel :: LoadHeader ( SaveLoadManager& m )
 {
-	std::string str;
-	m.i() >> str;
-	if ( str != InternalStateFileHeader )
+	if ( !m.isTag(InternalStateFileHeader) )
 		throw EFPPSaveLoad("Incompatible save/load header");
-	m.i() >> str;
+	std::string str = m.loadString();
 	// FIXME!! we don't check version equivalence for now
 //	if ( str != Version )
 //		return true;
-	int n;
-	m.i() >> n;
-	if ( n != bytesInInt )
+	if ( m.loadUInt() != bytesInInt )
 		throw EFPPSaveLoad("Saved file differ in word size");
+	if ( m.loadUInt() != byteOrderMark )
+		throw EFPPSaveLoad("Saved file differ in byte order");
 }
 
 //-- save/load options (Kernel.h)
@@ -152,14 +118,13 @@ ReasoningKernel :: LoadHeader ( SaveLoadManager& m )
 void
 ReasoningKernel :: SaveOptions ( SaveLoadManager& m ) const
 {
-	m.o() << "Options\n";
+	m.saveTag("Options");
 }
 
 void
 ReasoningKernel :: LoadOptions ( SaveLoadManager& m )
 {
-	std::string options;
-	m.i() >> options;
+	m.expectTag("Options");
 }
 
 //-- save/load KB (Kernel.h)
@@ -203,22 +168,14 @@ static void
 SaveTNECollection ( const TNECollection<T>& collection, SaveLoadManager& m, const std::set<const TNamedEntry*>& excluded )
 {
 	typename TNECollection<T>::const_iterator p, p_beg = collection.begin(), p_end = collection.end();
-	// get the max length of the identifier in the collection
-	unsigned int maxLength = 0, curLength, size = 0;
+	unsigned int size = 0;
 
 	for ( p = p_beg; p < p_end; ++p )
-	{
 		if ( excluded.count(*p) == 0 )
-		{
 			++size;
-			if ( maxLength < (curLength = strlen((*p)->getName())) )
-				maxLength = curLength;
-		}
-	}
 
-	// save number of entries and max length of the entry
+	// save number of entries
 	m.saveUInt(size);
-	m.saveUInt(maxLength);
 
 	// save names of all entries
 	for ( p = p_beg; p < p_end; ++p )
@@ -226,7 +183,7 @@ SaveTNECollection ( const TNECollection<T>& collection, SaveLoadManager& m, cons
 		// register all entries in the global map
 		m.registerE(*p);
 		if ( excluded.count(*p) == 0 )
-			m.o() << (*p)->getName() << "\n";
+			m.saveString((*p)->getName());
 	}
 
 	// save the entries itself
@@ -241,20 +198,11 @@ LoadTNECollection ( TNECollection<T>& collection, SaveLoadManager& m )
 	// sanity check: Load shall be done for the empty collection and only once
 //	fpp_assert ( size() == 0 );
 
-	unsigned int collSize, maxLength;
-	collSize = m.loadUInt();
-	maxLength = m.loadUInt();
-	++maxLength;
-	char* name = new char[maxLength];
+	unsigned int collSize = m.loadUInt();
 
 	// register all the named entries
 	for ( unsigned int j = 0; j < collSize; ++j )
-	{
-		m.i().getline ( name, maxLength, '\n' );
-		m.registerE(collection.get(name));
-	}
-
-	delete [] name;
+		m.registerE(collection.get(m.loadString()));
 
 	// load all the named entries
 //	for ( iterator p = begin(); p < end(); ++p )
@@ -269,16 +217,13 @@ static void
 SaveRoleMaster ( const RoleMaster& RM, SaveLoadManager& m )
 {
 	RoleMaster::const_iterator p, p_beg = RM.begin(), p_end = RM.end();
-	// get the max length of the identifier in the collection
-	unsigned int maxLength = 0, curLength, size = 0;
+	unsigned int size = 0;
 
-	for ( p = p_beg; p != p_end; p += 2, size++ )
-		if ( maxLength < (curLength = strlen((*p)->getName())) )
-			maxLength = curLength;
+	for ( p = p_beg; p != p_end; p += 2 )
+		++size;
 
-	// save number of entries and max length of the entry
+	// save number of entries
 	m.saveUInt(size);
-	m.saveUInt(maxLength);
 
 	// register const entries in the global map
 	m.registerE(RM.getBotRole());
@@ -290,7 +235,7 @@ SaveRoleMaster ( const RoleMaster& RM, SaveLoadManager& m )
 		TRole* R = *p;
 		m.registerE(R);
 		m.registerE(R->inverse());
-		m.o() << R->getName() << "\n";
+		m.saveString(R->getName());
 	}
 
 //	// save the entries itself
@@ -308,11 +253,7 @@ LoadRoleMaster ( RoleMaster& RM, SaveLoadManager& m )
 	// sanity check: Load shall be done for the empty collection and only once
 //	fpp_assert ( size() == 0 );
 
-	unsigned int RMSize, maxLength;
-	RMSize = m.loadUInt();
-	maxLength = m.loadUInt();
-	++maxLength;
-	char* name = new char[maxLength];
+	unsigned int RMSize = m.loadUInt();
 
 	// register const entries in the global map
 	m.registerE(RM.getBotRole());
@@ -321,14 +262,11 @@ LoadRoleMaster ( RoleMaster& RM, SaveLoadManager& m )
 	// register all the named entries
 	for ( unsigned int j = 0; j < RMSize; ++j )
 	{
-		m.i().getline ( name, maxLength, '\n' );
-		TRole* R = RM.ensureRoleName(name);
+		TRole* R = RM.ensureRoleName(m.loadString());
 		m.registerE(R);
 		m.registerE(R->inverse());
 	}
 
-	delete [] name;
-
 //	// load all the named entries
 //	for ( iterator p = begin(); p < end(); ++p )
 //		(*p)->Load(i);
@@ -389,7 +327,6 @@ static void
 SaveDLDag ( const DLDag& dag, SaveLoadManager& m )
 {
 	m.saveUInt(dag.size());
-	m.o() << "\n";
 	// skip fake vertex and TOP
 	for ( unsigned int i = 2; i < dag.size(); ++i )
 		dag[i].Save(m);
@@ -470,7 +407,6 @@ SaveSingleCache ( SaveLoadManager& m, BipolarPointer bp, const modelCacheInterfa
 	default:
 		fpp_unreachable();
 	}
-	m.o() << "\n";
 }
 
 static const modelCacheInterface*
@@ -501,7 +437,7 @@ LoadSingleCache ( SaveLoadManager& m )
 static void
 SaveDagCache ( const DLDag& dag, SaveLoadManager& m )
 {
-	m.o() << "\nDC";	// dag cache
+	m.saveTag("DC");	// dag cache
 	for ( unsigned int i = 2; i < dag.size(); ++i )
 	{
 		const DLVertex& v = dag[i];
@@ -514,8 +450,7 @@ SaveDagCache ( const DLDag& dag, SaveLoadManager& m )
 static void
 LoadDagCache ( DLDag& dag, SaveLoadManager& m )
 {
-	m.expectChar('D');
-	m.expectChar('C');
+	m.expectTag("DC");
 	while ( BipolarPointer bp = m.loadSInt() )
 		dag.setCache ( bp, LoadSingleCache(m) );
 }
@@ -539,24 +474,24 @@ void
 TBox :: Save ( SaveLoadManager& m )
 {
 	initPointerMaps(m);
-	m.o() << "\nDT";
+	m.saveTag("DT");
 	for ( DataTypeCenter::const_iterator p = DTCenter.begin(), p_end = DTCenter.end(); p != p_end; ++p )
 		SaveDataType(*p,m);
-	m.o() << "\nC";
+	m.saveTag("C");
 	std::set<const TNamedEntry*> empty;
 	SaveTNECollection(Concepts,m,empty);
-	m.o() << "\nI";
+	m.saveTag("I");
 	SaveTNECollection(Individuals,m,empty);
-	m.o() << "\nOR";
+	m.saveTag("OR");
 	SaveRoleMaster(ORM,m);
-	m.o() << "\nDR";
+	m.saveTag("DR");
 	SaveRoleMaster(DRM,m);
-	m.o() << "\nD";
+	m.saveTag("D");
 	DLHeap.removeQuery();
 	SaveDLDag(DLHeap,m);
 	if ( Status > kbCChecked )
 	{
-		m.o() << "\nCT";
+		m.saveTag("CT");
 		pTax->Save(m,empty);
 	}
 	SaveDagCache(DLHeap,m);
@@ -567,21 +502,18 @@ TBox :: Load ( SaveLoadManager& m, KBStatus status )
 {
 	Status = status;
 	initPointerMaps(m);
-	m.expectChar('D');
-	m.expectChar('T');
+	m.expectTag("DT");
 	for ( DataTypeCenter::iterator p = DTCenter.begin(), p_end = DTCenter.end(); p != p_end; ++p )
 		LoadDataType(*p,m);
-	m.expectChar('C');
+	m.expectTag("C");
 	LoadTNECollection(Concepts,m);
-	m.expectChar('I');
+	m.expectTag("I");
 	LoadTNECollection(Individuals,m);
-	m.expectChar('O');
-	m.expectChar('R');
+	m.expectTag("OR");
 	LoadRoleMaster(ORM,m);
-	m.expectChar('D');
-	m.expectChar('R');
+	m.expectTag("DR");
 	LoadRoleMaster(DRM,m);
-	m.expectChar('D');
+	m.expectTag("D");
 	DLHeap.setSubOrder();
 //	LoadDLDag(DLHeap,m);
 	if ( !VerifyDag(DLHeap,m) )
@@ -591,8 +523,7 @@ TBox :: Load ( SaveLoadManager& m, KBStatus status )
 	{
 		initTaxonomy();
 		pTaxCreator->setBottomUp(GCIs);
-		m.expectChar('C');
-		m.expectChar('T');
+		m.expectTag("CT");
 		pTax->Load(m);
 	}
 	LoadDagCache(DLHeap,m);
@@ -602,11 +533,11 @@ void
 TBox :: SaveTaxonomy ( SaveLoadManager& m, const std::set<const TNamedEntry*>& excluded )
 {
 	initPointerMaps(m);
-	m.o() << "\nC";
+	m.saveTag("C");
 	SaveTNECollection(Concepts,m,excluded);
-	m.o() << "\nI";
+	m.saveTag("I");
 	SaveTNECollection(Individuals,m,excluded);
-	m.o() << "\nCT";
+	m.saveTag("CT");
 	pTax->Save(m,excluded);
 }
 
@@ -614,14 +545,13 @@ void
 TBox :: LoadTaxonomy ( SaveLoadManager& m )
 {
 	initPointerMaps(m);
-	m.expectChar('C');
+	m.expectTag("C");
 	LoadTNECollection(Concepts,m);
-	m.expectChar('I');
+	m.expectTag("I");
 	LoadTNECollection(Individuals,m);
 	initTaxonomy();
 	pTaxCreator->setBottomUp(GCIs);
-	m.expectChar('C');
-	m.expectChar('T');
+	m.expectTag("CT");
 	pTax->Load(m);
 }
 
@@ -634,7 +564,7 @@ ReasoningKernel :: SaveIncremental ( SaveLoadManager& m ) const
 {
 	if ( !useIncrementalReasoning )
 		return;
-	m.o() << "\nQ";
+	m.saveTag("Q");
 	m.saveUInt(Name2Sig.size());
 	for ( NameSigMap::const_iterator p = Name2Sig.begin(), p_end = Name2Sig.end(); p != p_end; ++p )
 	{
@@ -651,8 +581,9 @@ ReasoningKernel :: LoadIncremental ( SaveLoadManager& m )
 {
 	if ( !useIncrementalReasoning )
 		return;
-	m.expectChar('Q');
+	m.expectTag("Q");
 	Name2Sig.clear();
+	Sig2Names.clear();
 	unsigned int size = m.loadUInt();
 	for ( unsigned int j = 0; j < size; j++ )
 	{
@@ -662,6 +593,7 @@ ReasoningKernel :: LoadIncremental ( SaveLoadManager& m )
 		for ( unsigned int k = 0; k < sigSize; k++ )
 			sig->add(m.loadEntity());
 		Name2Sig[entity] = sig;
+		indexSig ( entity, *sig, /*add=*/true );
 	}
 }
 
@@ -758,7 +690,6 @@ TaxonomyVertex :: SaveLabel ( SaveLoadManager& m ) const
 	m.saveUInt(synonyms.size());
 	for ( syn_iterator p = begin_syn(), p_end = end_syn(); p < p_end; ++p )
 		m.savePointer(*p);
-	m.o() << "\n";
 }
 
 void
@@ -780,7 +711,6 @@ TaxonomyVertex :: SaveNeighbours ( SaveLoadManager& m ) const
 	m.saveUInt(neigh(false).size());
 	for ( p = begin(false), p_end = end(false); p != p_end; ++p )
 		m.savePointer(*p);
-	m.o() << "\n";
 }
 
 void
@@ -808,7 +738,6 @@ Taxonomy :: Save ( SaveLoadManager& m, const std::set<const TNamedEntry*>& exclu
 
 	// save number of taxonomy elements
 	m.saveUInt(Graph.size()/*-excluded.size()*/);
-	m.o() << "\n";
 
 	// save labels for all verteces of the taxonomy
 	for ( p = p_beg; p != p_end; ++p )
@@ -847,15 +776,17 @@ Taxonomy :: Load ( SaveLoadManager& m )
 //----------------------------------------------------------
 
 static void
-SaveIndexSet ( SaveLoadManager& m, const TSetAsTree& Set )
+SaveIndexSet ( SaveLoadManager& m, const TSetAsHybrid& Set )
 {
-	m.saveUInt(Set.size());
-	for ( TSetAsTree::const_iterator p = Set.begin(), p_end = Set.end(); p != p_end; ++p )
+	std::vector<unsigned int> elems;
+	Set.getElements(elems);
+	m.saveUInt(elems.size());
+	for ( std::vector<unsigned int>::const_iterator p = elems.begin(), p_end = elems.end(); p != p_end; ++p )
 		m.saveUInt(*p);
 }
 
 static void
-LoadIndexSet ( SaveLoadManager& m, TSetAsTree& Set )
+LoadIndexSet ( SaveLoadManager& m, TSetAsHybrid& Set )
 {
 	unsigned int n = m.loadUInt();
 	for ( unsigned int i = 0; i < n; i++ )
@@ -965,7 +896,6 @@ DLVertex :: Save ( SaveLoadManager& m ) const
 		m.saveSInt(getC());
 		break;
 	}
-	m.o() << "\n";
 }
 
 void
@@ -1,5 +1,5 @@
 /* This file is part of the FaCT++ DL reasoner
-Copyright (C) 2013 by Dmitry Tsarkov
+Copyright (C) 2013-2014 by Dmitry Tsarkov
 
 This library is free software; you can redistribute it and/or
 modify it under the terms of the GNU Lesser General Public
@@ -17,6 +17,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
 #include <fstream>
+#include <iterator>
+
+#ifndef WINDOWS
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
 
 #include "SaveLoadManager.h"
 #include "tNamedEntry.h"
@@ -34,20 +42,63 @@ SaveLoadManager :: clearContent ( void ) const
 	remove(filename.c_str());
 }
 
+void
+SaveLoadManager :: openInput ( void )
+{
+#ifndef WINDOWS
+	// map the whole file into memory: all the pointers are saved as indices, so nothing else is necessary
+	int fd = open ( filename.c_str(), O_RDONLY );
+	if ( fd < 0 )
+		throw EFPPSaveLoad ( filename, /*save=*/false );
+	struct stat st;
+	if ( fstat ( fd, &st ) == 0 && st.st_size > 0 )
+	{
+		void* addr = mmap ( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+		if ( addr != MAP_FAILED )
+		{
+			close(fd);
+			inBegin = inCur = static_cast<const char*>(addr);
+			inEnd = inBegin + st.st_size;
+			inMapped = true;
+			return;
+		}
+	}
+	close(fd);
+#endif
+	// fall back to reading the whole file into the buffer
+	std::ifstream in ( filename.c_str(), std::ios::in | std::ios::binary );
+	if ( !in.good() )
+		throw EFPPSaveLoad ( filename, /*save=*/false );
+	inBuffer.assign ( std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() );
+	inBegin = inCur = inBuffer.empty() ? NULL : &inBuffer[0];
+	inEnd = inBegin + inBuffer.size();
+}
+
+void
+SaveLoadManager :: closeInput ( void )
+{
+#ifndef WINDOWS
+	if ( inMapped )
+		munmap ( const_cast<char*>(inBegin), inEnd - inBegin );
+#endif
+	std::vector<char>().swap(inBuffer);
+	inBegin = inCur = inEnd = NULL;
+	inMapped = false;
+}
+
 void
 SaveLoadManager :: prepare ( bool input )
 {
 	// close all previously open streams
-	delete ip;
+	closeInput();
 	delete op;
-	ip = NULL;
 	op = NULL;
 
 	// open a new one
 	if ( input )
-		ip = new std::ifstream(filename.c_str());
+		openInput();
 	else
-		op = new std::ofstream(filename.c_str());
+		op = new std::ofstream ( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
 }
 
 void
@@ -23,6 +23,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <iostream>
 #include <vector>
 #include <map>
+#include <cstring>
 
 #include "globaldef.h"
 #include "eFPPSaveLoad.h"
@@ -99,10 +100,18 @@ protected:	// members
 	std::string dirname;
 		/// file name
 	std::string filename;
-		/// input stream pointer
-	std::istream* ip;
 		/// output stream pointer
 	std::ostream* op;
+		/// start of the input (mapped file or buffer); NULL if there is no input
+	const char* inBegin;
+		/// current position in the input
+	const char* inCur;
+		/// end of the input
+	const char* inEnd;
+		/// true iff the input is a mapped file
+	bool inMapped;
+		/// buffer for the input if the file can not be mapped
+	std::vector<char> inBuffer;
 
 		// uint <-> named entity map for the current taxonomy
 	PointerMap<TNamedEntity> eMap;
@@ -111,13 +120,44 @@ protected:	// members
 		// uint <-> TaxonomyVertex map to update the taxonomy
 	PointerMap<TaxonomyVertex> tvMap;
 
+private:	// no copy
+		/// no copy c'tor
+	SaveLoadManager ( const SaveLoadManager& );
+		/// no assignment
+	SaveLoadManager& operator = ( const SaveLoadManager& );
+
+protected:	// methods
+		/// open the input file; map it into memory if possible
+	void openInput ( void );
+		/// close the input, unmapping it if necessary
+	void closeInput ( void );
+
+		/// save N raw bytes starting from P
+	void saveRaw ( const void* p, size_t n ) { op->write ( static_cast<const char*>(p), n ); }
+		/// @return pointer to the next N bytes of the input; @throw an exception if there is not enough input
+	const char* loadRaw ( size_t n )
+	{
+		if ( unlikely ( static_cast<size_t>(inEnd - inCur) < n ) )
+			throw EFPPSaveLoad ( filename, /*save=*/false );
+		const char* ret = inCur;
+		inCur += n;
+		return ret;
+	}
+
 public:		// methods
 		/// init c'tor: remember the S/L name
-	SaveLoadManager ( const std::string& name ) : dirname(name), ip(NULL), op(NULL) { filename = name+".fpp.state"; }
-		/// empty d'tor
+	SaveLoadManager ( const std::string& name )
+		: dirname(name)
+		, op(NULL)
+		, inBegin(NULL)
+		, inCur(NULL)
+		, inEnd(NULL)
+		, inMapped(false)
+		{ filename = name+".fpp.state"; }
+		/// d'tor: close all the files
 	~SaveLoadManager ( void )
 	{
-		delete ip;
+		closeInput();
 		delete op;
 	}
 
@@ -127,60 +167,80 @@ public:		// methods
 	bool existsContent ( void ) const;
 		/// clear all the content corresponding to the manager
 	void clearContent ( void ) const;
+		/// @return name of the file with the costs of the concept tests; it survives the content clearing
+	std::string getCostProfileName ( void ) const { return dirname+".fpp.costs"; }
 
 	// set up stream
 
 		/// prepare stream according to INPUT value
 	void prepare ( bool input );
-		/// get an input stream
-	std::istream& i ( void ) { return *ip; }
-		/// get an output stream
-	std::ostream& o ( void ) { return *op; }
 		/// check whether stream is in a good shape
 	void checkStream ( void ) const
 	{
-		if ( ip && unlikely(!ip->good()) )
-			throw EFPPSaveLoad ( filename, /*save=*/false);
 		if ( op && unlikely(!op->good()) )
 			throw EFPPSaveLoad ( filename, /*save=*/true);
 	}
 
-	// save/load primitives
+	// save/load primitives; all the data is saved in the binary form
 
+		/// save a TAG (sequence of chars without length) to mark a section of the file
+	void saveTag ( const char* tag ) { saveRaw ( tag, strlen(tag) ); }
 		/// load a single char from input, throw an exception if it is not a given one
-	inline void expectChar ( const char C )
+	void expectChar ( const char C )
 	{
-		char c;
-		i() >> c;
-		if ( c != C )
+		if ( *loadRaw(1) != C )
 			throw EFPPSaveLoad(C);
 	}
+		/// load a sequence of chars of the length of TAG; @return true iff it is the same as TAG
+	bool isTag ( const char* tag )
+	{
+		size_t n = strlen(tag);
+		return memcmp ( loadRaw(n), tag, n ) == 0;
+	}
+		/// load a TAG from input, throw an exception if there is another one
+	void expectTag ( const char* tag )
+	{
+		if ( !isTag(tag) )
+			throw EFPPSaveLoad ( std::string("Expected tag '") + tag + "' not found" );
+	}
 
 	// save/load integers
 
 		/// save unsigned integer
-	inline void saveUInt ( unsigned int n ) { o() << "(" << n << ")"; }
+	void saveUInt ( unsigned int n ) { saveRaw ( &n, sizeof(n) ); }
 		/// save signed integer
-	inline void saveSInt ( int n ) { o() << "(" << n << ")"; }
+	void saveSInt ( int n ) { saveRaw ( &n, sizeof(n) ); }
 		/// load unsigned integer
-	inline unsigned int loadUInt ( void )
+	unsigned int loadUInt ( void )
 	{
 		unsigned int ret;
-		expectChar('(');
-		i() >> ret;
-		expectChar(')');
+		memcpy ( &ret, loadRaw(sizeof(ret)), sizeof(ret) );
 		return ret;
 	}
 		/// load signed integer
-	inline int loadSInt ( void )
+	int loadSInt ( void )
 	{
 		int ret;
-		expectChar('(');
-		i() >> ret;
-		expectChar(')');
+		memcpy ( &ret, loadRaw(sizeof(ret)), sizeof(ret) );
 		return ret;
 	}
 
+	// save/load strings
+
+		/// save string S together with its length
+	void saveString ( const char* s )
+	{
+		unsigned int n = strlen(s);
+		saveUInt(n);
+		saveRaw ( s, n );
+	}
+		/// load string saved by saveString()
+	std::string loadString ( void )
+	{
+		unsigned int n = loadUInt();
+		return std::string ( loadRaw(n), n );
+	}
+
 	// pointer <-> int related methods
 
 		/// clear all maps
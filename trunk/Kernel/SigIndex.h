@@ -44,6 +44,8 @@ protected:	// members
 	AxiomVec NonLocal[2];
 		/// empty signature to test the non-locality
 	TSignature emptySig;
+		/// empty axiom set for the entities that do not appear in any axiom
+	AxiomVec Empty;
 		/// number of registered axioms
 	unsigned int nRegistered;
 		/// number of registered axioms
@@ -128,7 +130,11 @@ public:		// interface
 	// get the set by the index
 
 		/// given an entity, return a set of all axioms that tontain this entity in a signature
-	const AxiomVec& getAxioms ( const TNamedEntity* entity ) { return Base[entity]; }
+	const AxiomVec& getAxioms ( const TNamedEntity* entity ) const
+	{
+		EntityAxiomMap::const_iterator p = Base.find(entity);
+		return p == Base.end() ? Empty : p->second;
+	}
 		/// get the non-local axioms with top-locality value TOP
 	const AxiomVec& getNonLocal ( bool top ) const { return NonLocal[!top]; }
 
@@ -77,6 +77,7 @@ bool DlSatTester :: commonTacticBody ( const DLVertex& cur )
 	const_cast<DLVertex&>(cur).incUsage(isPositive(curConcept.bp()));
 #endif
 	incStat(nTacticCalls);
+	++nAllTactics;
 
 	// call proper tactic
 	switch ( cur.Type() )
@@ -325,12 +326,20 @@ bool DlSatTester :: planOrProcessing ( const DLVertex& cur, DepSet& dep )
 		{
 		case acrClash:	// clash found -- OK
 			dep.add(getClashSet());
+			if ( DLHeap.isAdaptiveOrder() )
+				OrActivity.bump(*q);
 			continue;
 		case acrExist:	// already have such concept -- save it to the 1st position
 			OrConceptsToTest.resize(1);
 			OrConceptsToTest[0] = C;
 			return true;
 		case acrDone:
+			if ( isNogood ( curNode, C.bp(), dep ) )	// the choice is known to fail
+			{
+				if ( DLHeap.isAdaptiveOrder() )
+					OrActivity.bump(*q);
+				continue;
+			}
 			OrConceptsToTest.push_back(C);
 			continue;
 		default:		// safety check
@@ -338,9 +347,26 @@ bool DlSatTester :: planOrProcessing ( const DLVertex& cur, DepSet& dep )
 		}
 	}
 
+	if ( DLHeap.isAdaptiveOrder() )
+		sortOrConceptsToTest();
+
 	return false;
 }
 
+void DlSatTester :: sortOrConceptsToTest ( void )
+{
+	// insertion sort: the number of disjuncts is small, and the DAG order is kept for equal entries
+	// note that the activities are kept for the DAG entries, i.e., for the negations of the disjuncts
+	for ( unsigned int i = 1, size = OrConceptsToTest.size(); i < size; ++i )
+	{
+		ConceptWDep x = OrConceptsToTest[i];
+		int j;
+		for ( j = i-1; j >= 0 && DLHeap.less ( inverse(x.bp()), inverse(OrConceptsToTest[j].bp()), OrActivity ); --j )
+			OrConceptsToTest[j+1] = OrConceptsToTest[j];
+		OrConceptsToTest[j+1] = x;
+	}
+}
+
 bool DlSatTester :: processOrEntry ( void )
 {
 	// save the context here as after save() it would be lost
@@ -350,6 +376,10 @@ bool DlSatTester :: processOrEntry ( void )
 	const char* reason = NULL;
 	DepSet dep;
 
+	// the previous entry failed: remember this for the adaptive OR ordering
+	if ( p != p_end && DLHeap.isAdaptiveOrder() )
+		OrActivity.bump(inverse((p_end-1)->bp()));
+
 	if ( bcOr->isLastOrEntry() )
 	{
 		// cumulative dep-set will be used
@@ -366,13 +396,18 @@ bool DlSatTester :: processOrEntry ( void )
 		// new (just branched) dep-set
 		dep = getCurDepSet();
 		incStat(nOrBrCalls);
+		addDecisionFact ( curNode, C.bp() );
 	}
 
 	// if semantic branching is in use -- add previous entries to the label
 	if ( useSemanticBranching() )
 		for ( ; p < p_end; ++p )
+		{
+			if ( reason == NULL )	// the entry is a part of the branching decision
+				addDecisionFact ( curNode, inverse(p->bp()) );
 			if ( addToDoEntry ( curNode, ConceptWDep(inverse(*p),dep), "sb" ) )
 				fpp_unreachable();	// Both Exists and Clash are errors
+		}
 
 	// add new entry to current node; we know the result would be DONE
 	return
@@ -1521,9 +1556,14 @@ bool DlSatTester :: applyChooseRule ( DlCompletionTree* node, BipolarPointer C )
 	// now node will be labelled with ~C or C
 	if ( isFirstBranchCall() )
 	{
+		DepSet dep;
+		if ( isNogood ( node, inverse(C), dep ) )	// ~C is known to fail
+			return addToDoEntry ( node, C, dep, "ng" );
+
 		createBCCh();
 		// save current state
 		save();
+		addDecisionFact ( node, inverse(C) );
 
 		return addToDoEntry ( node, inverse(C), getCurDepSet(), "cr0" );
 	}
@@ -1682,11 +1722,14 @@ bool DlSatTester :: checkProjection ( DlCompletionTreeArc* pA, BipolarPointer C,
 
 	if ( !curNode->isLabelledBy(C) )
 	{
-		if ( isFirstBranchCall() )
+		if ( isFirstBranchCall() && isNogood ( curNode, inverse(C), dep ) )	// ~C is known to fail
+			switchResult ( addToDoEntry ( curNode, C, dep, "ng" ) );
+		else if ( isFirstBranchCall() )
 		{
 			createBCCh();
 			// save current state
 			save();
+			addDecisionFact ( curNode, inverse(C) );
 
 			return addToDoEntry ( curNode, inverse(C), getCurDepSet(), "cr0" );
 		}
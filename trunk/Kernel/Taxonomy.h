@@ -21,6 +21,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 // taxonomy graph for DL
 
+#include <set>
+
 #include "taxVertex.h"
 
 class SaveLoadManager;
@@ -30,6 +32,8 @@ class Taxonomy
 protected:	// typedefs
 		/// type for a vector of TaxVertex
 	typedef std::vector<TaxonomyVertex*> TaxVertexVec;
+		/// set of vertices visited by a single traversal
+	typedef std::set<const TaxonomyVertex*> VisitedSet;
 
 protected:	// members
 		/// array of taxonomy vertices
@@ -82,17 +86,14 @@ public:		// classification interface
 	void deFinalise ( void );
 
 protected:	// methods
-		/// apply ACTOR to subgraph starting from NODE as defined by flags
+		/// apply ACTOR to subgraph starting from NODE as defined by flags; VISITED contains already processed vertices
 	template<bool onlyDirect, bool upDirection, class Actor>
-	void getRelativesInfoRec ( TaxonomyVertex* node, Actor& actor )
+	static void getRelativesInfoRec ( TaxonomyVertex* node, Actor& actor, VisitedSet& visited )
 	{
-		// recursive applicability checking
-		if ( isVisited(node) )
+		// recursive applicability checking; label node as visited
+		if ( !visited.insert(node).second )
 			return;
 
-		// label node as visited
-		setVisited(node);
-
 		// if current node processed OK and there is no need to continue -- exit
 		// if node is NOT processed for some reasons -- go to another level
 		if ( actor.apply(*node) && onlyDirect )
@@ -100,7 +101,7 @@ protected:	// methods
 
 		// apply method to the proper neighbours with proper parameters
 		for ( TaxonomyVertex::iterator p = node->begin(upDirection), p_end = node->end(upDirection); p != p_end; ++p )
-			getRelativesInfoRec<onlyDirect, upDirection> ( *p, actor );
+			getRelativesInfoRec<onlyDirect, upDirection> ( *p, actor, visited );
 	}
 
 public:		// interface
@@ -136,8 +137,9 @@ public:		// interface
 	void setCurrent ( TaxonomyVertex* cur ) { Current = cur; }
 
 		/// apply ACTOR to subgraph starting from NODE as defined by flags;
+		/// the visited vertices are kept per call, so several traversals could run at the same time
 	template<bool needCurrent, bool onlyDirect, bool upDirection, class Actor>
-	void getRelativesInfo ( TaxonomyVertex* node, Actor& actor )
+	void getRelativesInfo ( TaxonomyVertex* node, Actor& actor ) const
 	{
 		// if current node processed OK and there is no need to continue -- exit
 		// this is the helper to the case like getDomain():
@@ -146,10 +148,9 @@ public:		// interface
 			if ( actor.apply(*node) && onlyDirect )
 				return;
 
+		VisitedSet visited;
 		for ( TaxonomyVertex::iterator p = node->begin(upDirection), p_end = node->end(upDirection); p != p_end; ++p )
-			getRelativesInfoRec<onlyDirect, upDirection> ( *p, actor );
-
-		clearVisited();
+			getRelativesInfoRec<onlyDirect, upDirection> ( *p, actor, visited );
 	}
 
 	// taxonomy info access
@@ -217,6 +217,14 @@ protected:	// methods
 		delete ksStack.top();
 		ksStack.pop();
 		sigStack.pop();
+	}
+		/// remove all the entries from the stack together with the current one
+	void clearStack ( void )
+	{
+		while ( !waitStack.empty() )
+			removeTop();
+		Syns.clear();
+		pTax->getCurrent()->clear();
 	}
 		/// ensure that all TS of the top entry are classified. @return the reason of cycle or NULL.
 	ClassifiableEntry* prepareTS ( ClassifiableEntry* cur );
@@ -272,7 +280,15 @@ public:		// interface
 		// don't classify artificial concepts
 		if ( p->isNonClassifiable() )
 			return;
-		prepareTS(p);
+		try
+		{
+			prepareTS(p);
+		}
+		catch(...)
+		{	// classification is interrupted: forget the half-classified entries, so it could be restarted later
+			clearStack();
+			throw;
+		}
 	}
  		/// clear all labels from Taxonomy vertices
 	void clearLabels ( void ) { pTax->clearVisited(); valueLabel.newLabel(); }
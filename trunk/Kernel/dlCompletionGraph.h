@@ -20,6 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #define DLCOMPLETIONGRAPH_H
 
 #include <vector>
+#include <new>
 
 #include "globaldef.h"
 #include "DeletelessAllocator.h"
@@ -65,6 +66,18 @@ protected:	// types
 		~SaveState ( void ) {}
 	}; // SaveState
 
+		/// nodes that got some concept to their labels
+	struct LabelIndexEntry
+	{
+			/// the nodes; contains also nodes that lost the concept after backtracking
+		nodeBaseType Nodes;
+			/// true iff the nodes are sorted by their IDs
+		bool Sorted;
+
+			/// empty c'tor
+		LabelIndexEntry ( void ) : Sorted(true) {}
+	}; // LabelIndexEntry
+
 private:	// constants
 		/// initial value of IR level
 	static const unsigned int initIRLevel = 0;
@@ -76,6 +89,8 @@ private:	// members
 protected:	// members
 		/// heap itself
 	nodeBaseType NodeBase;
+		/// chunks of memory that keep the nodes; the ID of the first node of a chunk is its index in the heap
+	nodeBaseType NodeChunks;
 		/// nodes, saved on current branching level
 	nodeBaseType SavedNodes;
 		/// host reasoner
@@ -92,6 +107,12 @@ protected:	// members
 	TRareSaveStack RareStack;
 		/// stack for usual saving/restoring
 	TSaveStack<SaveState> Stack;
+		/// nodes that got a concept to the label, indexed by the concept; used to find a candidate for anywhere blocking
+	std::vector<LabelIndexEntry> LabelIndex;
+		/// entries of the LabelIndex that are not empty
+	std::vector<unsigned int> UsedLabelIndex;
+		/// true iff the LabelIndex is maintained; it is built when the graph becomes large
+	bool useLabelIndex;
 
 	// helpers for the output
 
@@ -108,11 +129,19 @@ protected:	// members
 	unsigned int nNodeRestores;
 		/// maximal size of the graph
 	unsigned int maxGraphSize;
+		/// number of searches for an anywhere blocker
+	unsigned int nBlockerSearches;
+		/// number of nodes checked as a blocker during these searches
+	unsigned int nBlockerTests;
 
 	// flags
 
+		/// minimal size of the graph for which the candidates for anywhere blocking are taken from the label index
+	static unsigned int minIndexedGraphSize ( void ) { return 256; }
 		/// how many nodes skip before block; work only with FAIRNESS
 	int nSkipBeforeBlock;
+		/// number of nodes kept after a larger graph is cleared; 0 means keep all the nodes
+	unsigned int maxKeptNodes;
 		/// use or not lazy blocking (ie test blocking only expanding exists)
 	bool useLazyBlocking;
 		/// whether to use Anywhere blocking as opposed to an ancestor one
@@ -124,17 +153,36 @@ protected:	// members
 	bool sessionHasNumberRestrictions;
 
 protected:	// methods
-		/// init vector [B,E) with new objects T
-	void initNodeArray ( iterator b, iterator e )
+		/// add N new nodes to the heap; the nodes are placed in a single chunk of memory
+	void addNodes ( size_t n )
 	{
-		for ( iterator p = b; p != e; ++p )
-			*p = new DlCompletionTree(nodeId++);
+		DlCompletionTree* chunk = static_cast<DlCompletionTree*>(::operator new(n*sizeof(DlCompletionTree)));
+		NodeChunks.push_back(chunk);
+		NodeBase.reserve(NodeBase.size()+n);
+		for ( size_t i = 0; i < n; ++i )
+			NodeBase.push_back ( new (chunk+i) DlCompletionTree(nodeId++) );
+	}
+		/// delete the last chunk of nodes
+	void deleteLastChunk ( void )
+	{
+		DlCompletionTree* chunk = NodeChunks.back();
+		unsigned int start = chunk->getId();
+		for ( iterator p = NodeBase.begin()+start, p_end = NodeBase.end(); p != p_end; ++p )
+			(*p)->~DlCompletionTree();
+		::operator delete(chunk);
+		NodeBase.resize(start);
+		NodeChunks.pop_back();
+		nodeId = start;
 	}
 		/// increase heap size
-	void grow ( void )
+	void grow ( void ) { addNodes ( NodeBase.empty() ? 1 : NodeBase.size() ); }
+		/// free memory of the nodes and arcs beyond the limit set by maxKeptNodes; the graph should be empty
+	void releaseMemory ( void )
 	{
-		NodeBase.resize(NodeBase.size()*2);
-		initNodeArray ( NodeBase.begin()+NodeBase.size()/2, NodeBase.end() );
+		// there are usually 2 arcs (to and from parent) per node
+		while ( NodeChunks.size() > 1 && NodeChunks.back()->getId() >= maxKeptNodes )
+			deleteLastChunk();
+		CTEdgeHeap.shrink(2*maxKeptNodes);
 	}
 		/// init root node
 	void initRoot ( void )
@@ -176,8 +224,53 @@ protected:	// methods
 	bool isStillDBlocked ( const DlCompletionTree* node ) const { return node->isDBlocked() && isBlockedBy ( node, node->Blocker ); }
 		/// try to find d-blocker for a node using ancestor blocking
 	void findDAncestorBlocker ( DlCompletionTree* node );
+		/// check whether P can block NODE; if so, mark NODE as d-blocked by P
+	bool tryBlocker ( DlCompletionTree* node, const DlCompletionTree* p )
+	{
+		// node was merge to smth with the larger ID or is cached or blocked itself
+		if ( p->isBlocked() || p->isPBlocked() || p->isNominalNode() || p->isCached() )
+			return false;
+
+		++nBlockerTests;
+		if ( !isBlockedBy ( node, p ) )
+			return false;
+
+		setNodeDBlocked ( node, p );
+		return true;
+	}
 		/// try to find d-blocker for a node using anywhere blocking
 	void findDAnywhereBlocker ( DlCompletionTree* node );
+		/// @return entry of the LabelIndex for a concept BP
+	static unsigned int getLabelIndexKey ( BipolarPointer bp ) { return isPositive(bp) ? 2*bp : -2*bp+1; }
+		/// register that NODE has BP in its label
+	void addToLabelIndex ( DlCompletionTree* node, BipolarPointer bp )
+	{
+		unsigned int key = getLabelIndexKey(bp);
+		if ( key >= LabelIndex.size() )
+			LabelIndex.resize(key+1);
+		LabelIndexEntry& entry = LabelIndex[key];
+		if ( entry.Nodes.empty() )
+			UsedLabelIndex.push_back(key);
+		else if ( entry.Nodes.back()->getId() >= node->getId() )
+			entry.Sorted = false;
+		entry.Nodes.push_back(node);
+	}
+		/// build the label index for all the nodes of the graph
+	void buildLabelIndex ( void );
+		/// clear the label index
+	void clearLabelIndex ( void )
+	{
+		useLabelIndex = false;
+		for ( std::vector<unsigned int>::iterator p = UsedLabelIndex.begin(), p_end = UsedLabelIndex.end(); p != p_end; ++p )
+		{
+			LabelIndex[*p].Nodes.clear();
+			LabelIndex[*p].Sorted = true;
+		}
+		UsedLabelIndex.clear();
+	}
+		/// @return the smallest set of nodes (sorted by ID) that contains all the possible blockers of a NODE
+		/// together with the concept BP that all the blockers have; NULL if there is no such a set
+	const nodeBaseType* getBlockerCandidates ( const DlCompletionTree* node, BipolarPointer& bp );
 		/// try to find d-blocker for a node
 	void findDBlocker ( DlCompletionTree* node )
 	{
@@ -262,34 +355,41 @@ protected:	// methods
 public:		// interface
 		/// c'tor: make INIT_SIZE objects
 	DlCompletionGraph ( unsigned int initSize, DlSatTester* p )
-		: NodeBase(initSize)
-		, pReasoner(p)
+		: pReasoner(p)
 		, nodeId(0)
 		, endUsed(0)
 		, branchingLevel(InitBranchingLevelValue)
 		, IRLevel(initIRLevel)
+		, useLabelIndex(false)
 		, maxGraphSize(0)
+		, maxKeptNodes(0)
+		, sessionHasInverseRoles(false)
+		, sessionHasNumberRestrictions(false)
 	{
-		initNodeArray ( NodeBase.begin(), NodeBase.end() );
+		addNodes ( initSize ? initSize : 1 );
 		clearStatistics();
 		initRoot();
 	}
 		/// d'tor: delete all allocated nodes
 	~DlCompletionGraph ( void )
 	{
-		for ( iterator p = NodeBase.begin(); p != NodeBase.end(); ++p )
-			delete *p;
+		while ( !NodeChunks.empty() )
+			deleteLastChunk();
 	}
 
 	// flag setting
 
 		/// set flags for blocking
-	void initContext ( int nSkip, bool useLB, bool useAB )
+	void initContext ( int nSkip, bool useLB, bool useAB, unsigned int maxKept )
 	{
 		nSkipBeforeBlock = nSkip;
+		maxKeptNodes = maxKept;
 		useLazyBlocking = useLB;
 		useAnywhereBlocking = useAB;
 	}
+		/// @return true iff the blocking method of a session is the one for the given flags
+	bool isBlockingMethod ( bool hasInverse, bool hasQCR ) const
+		{ return sessionHasInverseRoles == hasInverse && sessionHasNumberRestrictions == hasQCR; }
 		/// set blocking method for a session
 	void setBlockingMethod ( bool hasInverse, bool hasQCR )
 	{
@@ -300,6 +400,8 @@ public:		// interface
 	void addConceptToNode ( DlCompletionTree* node, const ConceptWDep& c, DagTag tag )
 	{
 		node->addConcept(c,tag);
+		if ( useLabelIndex )
+			addToLabelIndex ( node, c.bp() );
 
 		if ( useLazyBlocking )
 			node->setAffected();
@@ -394,6 +496,8 @@ public:		// interface
 	{
 		nNodeSaves = 0;
 		nNodeRestores = 0;
+		nBlockerSearches = 0;
+		nBlockerTests = 0;
 		if ( maxGraphSize < endUsed )
 			maxGraphSize = endUsed;
 	}
@@ -402,11 +506,14 @@ public:		// interface
 	{
 		CTEdgeHeap.clear();
 		endUsed = 0;
+		if ( maxKeptNodes > 0 && NodeBase.size() > maxKeptNodes )
+			releaseMemory();
 		branchingLevel = InitBranchingLevelValue;
 		IRLevel = initIRLevel;
 		RareStack.clear();
 		Stack.clear();
 		SavedNodes.clear();
+		clearLabelIndex();
 		initRoot();
 	}
 		/// get number of nodes in the CGraph
@@ -512,6 +619,10 @@ public:		// interface
 	unsigned int getNNodeSaves ( void ) const { return nNodeSaves; }
 		/// get number of nodes restored during session
 	unsigned int getNNodeRestores ( void ) const { return nNodeRestores; }
+		/// get number of searches for an anywhere blocker during session
+	unsigned int getNBlockerSearches ( void ) const { return nBlockerSearches; }
+		/// get number of nodes checked as a blocker during session
+	unsigned int getNBlockerTests ( void ) const { return nBlockerTests; }
 
 	// print
 
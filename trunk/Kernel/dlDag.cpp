@@ -28,6 +28,7 @@ DLDag :: DLDag ( const ifOptionSet* Options )
 	, indexLE(*this)
 	, finalDagSize(0)
 	, nCacheHits(0)
+	, adaptiveOrder(false)
 	, useDLVCache(true)
 {
 	Heap.push_back ( new DLVertex (dtBad) );	// empty vertex -- bpINVALID
@@ -70,6 +71,7 @@ void DLDag :: readConfig ( const ifOptionSet* Options )
 
 	orSortSat = Options->getText ( "orSortSat" ).c_str();
 	orSortSub = Options->getText ( "orSortSub" ).c_str();
+	orSortSeed = Options->getInt ( "orSortSeed" );
 
 	if ( !isCorrectOption(orSortSat) || !isCorrectOption(orSortSub) )
 		throw EFaCTPlusPlus ( "DAG: wrong OR sorting options" );
@@ -98,6 +100,8 @@ DLDag :: setOrderDefaults ( const char* defSat, const char* defSub )
 /// set OR sort flags based on given option string
 void DLDag :: setOrderOptions ( const char* opt )
 {
+	adaptiveOrder = false;
+
 	// 0x means not to use OR sort
 	if ( opt[0] == '0' )
 		return;
@@ -105,6 +109,13 @@ void DLDag :: setOrderOptions ( const char* opt )
 	sortAscend = (opt[1] == 'a');
 	preferNonGen = (opt[2] == 'p');
 
+	// Ax means the order is defined by the reasoner during the tests; keep the DAG as it is
+	if ( opt[0] == 'A' )
+	{
+		adaptiveOrder = true;
+		return;
+	}
+
 	// all statistics use negative version (as it is used in disjunctions)
 	iSort = opt[0] == 'S' ? DLVertex::getStatIndexSize(false)
 		  : opt[0] == 'D' ? DLVertex::getStatIndexDepth(false)
@@ -302,6 +313,29 @@ bool DLDag :: less ( BipolarPointer p1, BipolarPointer p2 ) const
 		return key2 < key1;
 }
 
+/// return true if p1 is less than p2 using activities of the entries in clashes
+bool DLDag :: less ( BipolarPointer p1, BipolarPointer p2, const TConceptActivity& Activity ) const
+{
+#	ifdef ENABLE_CHECKING
+		fpp_assert ( isValid(p1) && isValid(p2) );
+#	endif
+
+	// idea: any positive entry should go first
+	if ( preferNonGen )
+	{
+		if ( isNegative(p1) && isPositive(p2) )
+			return true;
+		if ( isPositive(p1) && isNegative(p2) )
+			return false;
+	}
+
+	// return "less" wrt sortAscend
+	if ( sortAscend )
+		return Activity.less ( p1, p2 );
+	else
+		return Activity.less ( p2, p1 );
+}
+
 #ifdef RKG_PRINT_DAG_USAGE
 /// print usage of DAG
 void DLDag :: PrintDAGUsage ( std::ostream& o ) const
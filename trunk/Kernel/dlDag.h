@@ -30,6 +30,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "tRole.h"
 #include "ConceptWithDep.h"
 #include "tNECollection.h"
+#include "tConceptActivity.h"
 
 class RoleMaster;
 class TConcept;
@@ -72,6 +73,10 @@ protected:	// members
 	bool sortAscend;
 		/// prefer non-generating rules in OR orderings
 	bool preferNonGen;
+		/// order OR vertices dynamically wrt the activity of the disjuncts in clashes
+	bool adaptiveOrder;
+		/// seed for breaking ties in the adaptive OR ordering
+	unsigned int orSortSeed;
 
 		/// flag whether cache should be used
 	bool useDLVCache;
@@ -97,7 +102,7 @@ protected:	// methods
 			 Order = n >= 2 ? str[1] : 'a',
 			 NGPref = n == 3 ? str[2] : 'p';
 		return ( Method == 'S' || Method == 'D' || Method == 'F' ||
-				 Method == 'B' || Method == 'G' || Method == '0' )
+				 Method == 'B' || Method == 'G' || Method == 'A' || Method == '0' )
 			&& ( Order == 'a' || Order == 'd' ) && ( NGPref == 'p' || NGPref == 'n' );
 	}
 		/// gather vertex statistics (no freq)
@@ -210,6 +215,8 @@ public:		// interface
 	void setExpressionCache ( bool val ) { useDLVCache = val; }
 		/// return true if p1 is less than p2 using chosen sort order
 	bool less ( BipolarPointer p1, BipolarPointer p2 ) const;
+		/// return true if p1 is less than p2 using activities of the entries in clashes
+	bool less ( BipolarPointer p1, BipolarPointer p2, const TConceptActivity& Activity ) const;
 
 		/// access by index (non-const version)
 	DLVertex& operator [] ( BipolarPointer i )
@@ -258,6 +265,10 @@ public:		// interface
 	void setSubOrder ( void ) { setOrderOptions(orSortSub); }
 		/// use SAT options to OR ordering;
 	void setSatOrder ( void ) { setOrderOptions(orSortSat); }
+		/// @return true iff OR vertices are ordered wrt the activities of the disjuncts
+	bool isAdaptiveOrder ( void ) const { return adaptiveOrder; }
+		/// @return seed for breaking ties in the adaptive OR ordering
+	unsigned int getOrSortSeed ( void ) const { return orSortSeed; }
 		/// gather statistics necessary for the OR ordering
 	void gatherStatistic ( void );
 
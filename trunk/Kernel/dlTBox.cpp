@@ -25,8 +25,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "globaldef.h"
 #include "ReasonerNom.h"
 #include "DLConceptTaxonomy.h"
+#include "ELFReasoner.h"
 #include "procTimer.h"
 #include "dumpLisp.h"
+#include "tCostProfile.h"
+#include "tABoxPartition.h"
+#include "ParallelABoxChecker.h"
+#include "ParallelInstanceChecker.h"
 #include "logging.h"
 
 // uncomment the following line to print currently checking subsumption
@@ -37,9 +42,12 @@ TBox :: TBox ( const ifOptionSet* Options, const std::string& TopORoleName, cons
 	, stdReasoner(NULL)
 	, nomReasoner(NULL)
 	, pMonitor(NULL)
+	, pOperations(NULL)
 	, pTax(NULL)
 	, pTaxCreator(NULL)
+	, pELFReasoner(NULL)
 	, pName2Sig(NULL)
+	, pCostProfile(NULL)
 	, pOptions (Options)
 	, Status(kbLoading)
 	, curFeature(NULL)
@@ -49,12 +57,20 @@ TBox :: TBox ( const ifOptionSet* Options, const std::string& TopORoleName, cons
 	, ORM ( /*data=*/false, TopORoleName, BotORoleName )
 	, DRM ( /*data=*/true, TopDRoleName, BotDRoleName )
 	, Axioms(*this)
+	, pRelatedIndex(NULL)
+	, pABoxPartition(NULL)
+	, pChangedIndividuals(NULL)
 	, Splits(NULL)
 	, T_G(bpTOP)	// initialise GCA's concept with Top
 	, nC(0)
 	, nR(0)
 	, auxConceptID(0)
 	, testTimeout(0)
+	, nClassificationThreads(1)
+	, nRetrievalIndividuals(0)
+	, nRetrievalMerged(0)
+	, nRetrievalParallelTests(0)
+	, nRetrievalDroppedTests(0)
 	, useNodeCache(true)
 	, duringClassification(false)
 	, useSortedReasoning(true)
@@ -75,6 +91,8 @@ TBox :: ~TBox ( void )
 	// remove all RELATED structures
 	for ( RelatedCollection::iterator p = RelatedI.begin(), p_end = RelatedI.end(); p < p_end; ++p )
 		delete *p;
+	delete pRelatedIndex;
+	delete pABoxPartition;
 
 	// remove all simple rules
 	for ( TSimpleRules::iterator q = SimpleRules.begin(), q_end = SimpleRules.end(); q < q_end; ++q )
@@ -95,6 +113,7 @@ TBox :: ~TBox ( void )
 	delete nomReasoner;
 	delete pTax;
 	delete pTaxCreator;
+	delete pELFReasoner;
 }
 
 /// get unique aux concept
@@ -196,18 +215,28 @@ void TBox :: prepareReasoning ( void )
 	DLHeap.setSatOrder();
 }
 
-/// prepare features for SAT(P), or SUB(P,Q) test
-void TBox :: prepareFeatures ( const TConcept* pConcept, const TConcept* qConcept )
+/// fill LF with features for SAT(P), or SUB(P,Q) test; doesn't change the TBox
+void TBox :: fillQueryFeatures ( LogicFeatures& lf, const TConcept* pConcept, const TConcept* qConcept ) const
 {
-	auxFeatures = GCIFeatures;
+	lf = GCIFeatures;
 	if ( pConcept != NULL )
-		updateAuxFeatures(pConcept->posFeatures);
+		updateFeatures ( lf, pConcept->posFeatures );
 	if ( qConcept != NULL )
-		updateAuxFeatures(qConcept->negFeatures);
-	if ( auxFeatures.hasSingletons() )
-		updateAuxFeatures(NCFeatures);
+		updateFeatures ( lf, qConcept->negFeatures );
+	if ( lf.hasSingletons() )
+		updateFeatures ( lf, NCFeatures );
+}
+
+/// prepare features for SAT(P), or SUB(P,Q) test
+void TBox :: prepareFeatures ( const TConcept* pConcept, const TConcept* qConcept )
+{
+	fillQueryFeatures ( auxFeatures, pConcept, qConcept );
 	curFeature = &auxFeatures;
 
+	// the nominal reasoner works over the individuals of the test
+	if ( curFeature->hasSingletons() )
+		prepareNominalCloud ( pConcept, qConcept );
+
 	// set blocking method for the current reasoning session
 	getReasoner()->setBlockingMethod ( isIRinQuery(), isNRinQuery() );
 }
@@ -260,7 +289,7 @@ TBox :: performConsistencyCheck ( void )
 		if ( DLHeap.getCache(bpTOP) == NULL )
 			initConstCache(bpTOP);
 
-		ret = static_cast<NominalReasoner*>(nomReasoner)->consistentNominalCloud();
+		ret = checkABox();
 	}
 	else
 		ret = isSatisfiable(pTop);
@@ -281,6 +310,165 @@ TBox :: performConsistencyCheck ( void )
 	return ret;
 }
 
+/// check whether the ABox is consistent; split it into independent components if possible
+bool
+TBox :: checkABox ( void )
+{
+	// nominals and the top role could connect any individuals
+	if ( nNominalReferences == 0 && !KBFeatures.hasTopRole() )
+	{
+		TABoxPartition* partition = new TABoxPartition(*this);
+		if ( partition->size() > 1 )
+		{
+			pABoxPartition = partition;
+			static_cast<NominalReasoner*>(nomReasoner)->setPartition(pABoxPartition);
+			return checkABoxComponents();
+		}
+		delete partition;
+	}
+
+	return static_cast<NominalReasoner*>(nomReasoner)->consistentNominalCloud();
+}
+
+/// check the (changed) components of the ABox partition; @return true if they are consistent
+bool
+TBox :: checkABoxComponents ( void )
+{
+	NominalReasoner* Reasoner = static_cast<NominalReasoner*>(nomReasoner);
+
+	// the unchanged components are known to be consistent; their individuals are registered before use
+	std::vector<unsigned int> ToCheck;
+	UnregisteredComponents.clear();
+	for ( unsigned int i = 0; i < pABoxPartition->size(); ++i )
+		if ( isChangedComponent(i) )
+			ToCheck.push_back(i);
+		else
+			UnregisteredComponents.push_back(i);
+
+	if ( verboseOutput )
+		std::cerr << " " << ToCheck.size() << " of " << pABoxPartition->size() << " ABox components...";
+
+	// check the components in parallel if required; the failed ones are re-checked in the main thread
+	if ( nClassificationThreads > 1 && ToCheck.size() > 1 )
+	{
+		ParallelABoxChecker Checker ( *this, *pABoxPartition, nClassificationThreads );
+		for ( std::vector<unsigned int>::const_iterator p = ToCheck.begin(), p_end = ToCheck.end(); p != p_end; ++p )
+			Checker.addComponent(*p);
+		Checker.run();
+		if ( Checker.getNDropped() > 0 && LLM.isWritable(llAlways) )
+			LL << "\n" << Checker.getNDropped() << " of " << Checker.size()
+			   << " ABox components failed in the threads and were re-checked serially";
+
+		ToCheck.clear();
+		for ( unsigned int i = 0; i < Checker.size(); ++i )
+			if ( Checker.getResult(i) == 0 )
+				return false;
+			else if ( Checker.getResult(i) < 0 )
+				ToCheck.push_back(Checker.getComponent(i));
+	}
+
+	std::set<unsigned int> comps;
+	for ( std::vector<unsigned int>::const_iterator p = ToCheck.begin(), p_end = ToCheck.end(); p != p_end; ++p )
+	{
+		comps.clear();
+		comps.insert(*p);
+		Reasoner->initCloud(comps);
+		if ( !Reasoner->consistentNominalCloud() )
+			return false;
+	}
+
+	// the nominal reasoner needs a consistent cloud below its barrier
+	if ( !Reasoner->hasCloud() )
+	{
+		comps.clear();
+		comps.insert(0);
+		Reasoner->initCloud(comps);
+		return Reasoner->consistentNominalCloud();
+	}
+
+	return true;
+}
+
+/// @return true iff the component I of the ABox partition contains changed individuals
+bool
+TBox :: isChangedComponent ( unsigned int i ) const
+{
+	if ( pChangedIndividuals == NULL )
+		return true;
+	const TABoxPartition::SingletonVector& Inds = (*pABoxPartition)[i].Individuals;
+	for ( TABoxPartition::SingletonVector::const_iterator p = Inds.begin(), p_end = Inds.end(); p != p_end; ++p )
+		if ( pChangedIndividuals->count((*p)->getEntity()) > 0 )
+			return true;
+	return false;
+}
+
+/// make the caches and merges of the individuals of the components that were not checked
+void
+TBox :: registerABoxComponents ( void )
+{
+	// the cloud of the component registers its individuals; it is consistent as the component was not changed
+	std::vector<unsigned int> comps;
+	comps.swap(UnregisteredComponents);
+	for ( std::vector<unsigned int>::const_iterator p = comps.begin(), p_end = comps.end(); p != p_end && pABoxPartition != NULL; ++p )
+	{
+		prepareFeatures ( (*pABoxPartition)[*p].Individuals.front(), NULL );
+		clearFeatures();
+	}
+}
+
+/// make the nominal cloud contain the individuals among P and Q; the whole ABox is used if there are none
+void
+TBox :: prepareNominalCloud ( const TConcept* p, const TConcept* q )
+{
+	if ( pABoxPartition == NULL )
+		return;
+
+	NominalReasoner* Reasoner = static_cast<NominalReasoner*>(nomReasoner);
+	std::set<unsigned int> comps;
+	unsigned int n = pABoxPartition->size();
+	// without nominals in the concepts only the components of the individuals are involved in the test
+	if ( p != NULL && p->isSingleton() )
+		comps.insert ( pABoxPartition->getComponent ( resolveSynonym(static_cast<const TIndividual*>(p)) ) );
+	if ( q != NULL && q->isSingleton() )
+		comps.insert ( pABoxPartition->getComponent ( resolveSynonym(static_cast<const TIndividual*>(q)) ) );
+	if ( comps.empty() )
+		for ( unsigned int i = 0; i < n; ++i )
+			comps.insert(i);
+
+	// nominals of the queries connect the components; new individuals are not in the partition
+	if ( nNominalReferences > 0 || comps.count(n) > 0 )
+	{
+		Reasoner->setPartition(NULL);
+		delete pABoxPartition;
+		pABoxPartition = NULL;
+		UnregisteredComponents.clear();
+		comps.clear();
+	}
+	else if ( Reasoner->hasComponents(comps) )
+		return;
+
+	// the union of the consistent components is consistent
+	Reasoner->initCloud(comps);
+	if ( !Reasoner->consistentNominalCloud() )
+		fpp_unreachable();
+}
+
+/// start measuring the cost of a test made by the current reasoner (if the costs are recorded)
+void
+TBox :: startCost ( TCostMeter& meter ) const
+{
+	if ( pCostProfile != NULL )
+		meter.start ( getReasoner()->getNTactics(), getReasoner()->getNBranches() );
+}
+
+/// finish measuring the cost of a test of the concept C; record the cost (if the costs are recorded)
+void
+TBox :: finishCost ( TCostMeter& meter, const TConcept* C ) const
+{
+	if ( pCostProfile != NULL )
+		pCostProfile->add ( C->getName(), meter.finish ( getReasoner()->getNTactics(), getReasoner()->getNBranches() ) );
+}
+
 bool
 TBox :: isSatisfiable ( const TConcept* pConcept )
 {
@@ -300,7 +488,10 @@ TBox :: isSatisfiable ( const TConcept* pConcept )
 
 	// perform reasoning with a proper logical features
 	prepareFeatures ( pConcept, NULL );
+	TCostMeter meter;
+	startCost(meter);
 	bool result = getReasoner()->runSat ( pConcept->resolveId(), bpTOP );
+	finishCost ( meter, pConcept );
 	// save cache
 	DLHeap.setCache ( pConcept->pName, getReasoner()->buildCacheByCGraph(result) );
 	clearFeatures();
@@ -339,7 +530,10 @@ TBox :: isSubHolds ( const TConcept* pConcept, const TConcept* qConcept )
 
 	// perform reasoning with a proper logical features
 	prepareFeatures ( pConcept, qConcept );
-	bool result = !getReasoner()->runSat ( pConcept->resolveId(), inverse(qConcept->resolveId()) );
+	TCostMeter meter;
+	startCost(meter);
+	bool result = !getReasoner()->runSatOverModel ( pConcept->resolveId(), inverse(qConcept->resolveId()) );
+	finishCost ( meter, pConcept );
 	clearFeatures();
 
 #ifdef FPP_DEBUG_PRINT_CURRENT_SUBSUMPTION
@@ -362,6 +556,119 @@ TBox :: isSubHolds ( const TConcept* pConcept, const TConcept* qConcept )
 	return result;
 }
 
+/// set RESULT into the instances of the concept C; the tableau is used only if the model merging fails
+void
+TBox :: retrieveInstances ( const TConcept* C, TIndividual::CIVec& Result )
+{
+	Result.clear();
+	if ( !isValid(C->pName) )	// fresh concept has no instances
+		return;
+
+	// all the tests form a single operation
+	TOperationGuard guard(pOperations);
+
+	// every individual needs its cache
+	registerABoxComponents();
+
+	// individual I is an instance of C iff I and ~C can't be merged
+	const modelCacheInterface* nCache = initCache ( C, /*sub=*/true );
+	std::set<const TIndividual*> Instances;
+	TIndividual::CIVec Candidates;
+	unsigned long nInd = 0, nNonInstances = 0;
+
+	for ( i_iterator pi = i_begin(), pi_end = i_end(); pi != pi_end; ++pi )
+	{
+		const TIndividual* ind = *pi;
+		if ( ind->isSynonym() )	// synonyms have the same instances as their representatives
+			continue;
+		++nInd;
+		const modelCacheInterface* cache = DLHeap.getCache(ind->pName);
+		switch ( cache == NULL ? csUnknown : cache->canMerge(nCache) )
+		{
+		case csValid:	// there is a model of I and ~C
+			++nNonInstances;
+			break;
+		case csInvalid:	// deterministic clash between I and ~C
+			Instances.insert(ind);
+			break;
+		default:		// the tableau test is necessary
+			Candidates.push_back(ind);
+			break;
+		}
+	}
+
+	unsigned long nInstances = Instances.size(), nCandidates = Candidates.size(), nParallel = 0, nDropped = 0;
+
+	// independent components could be checked in parallel; the failed candidates are re-checked in the main thread
+	if ( pABoxPartition != NULL && nClassificationThreads > 1 && Candidates.size() > 1 )
+	{
+		ParallelInstanceChecker Checker ( *this, *pABoxPartition, C, nClassificationThreads );
+		for ( TIndividual::CIVec::const_iterator p = Candidates.begin(), p_end = Candidates.end(); p != p_end; ++p )
+			Checker.addCandidate(*p);
+		Checker.run();
+		nParallel = Checker.getNParallelTests();
+		nDropped = Checker.getNDroppedTests();
+
+		Candidates.clear();
+		for ( unsigned int i = 0; i < Checker.size(); ++i )
+			if ( Checker.getResult(i) > 0 )
+				Instances.insert(Checker.getCandidate(i));
+			else if ( Checker.getResult(i) < 0 )
+				Candidates.push_back(Checker.getCandidate(i));
+	}
+
+	for ( TIndividual::CIVec::const_iterator p = Candidates.begin(), p_end = Candidates.end(); p != p_end; ++p )
+		if ( isSubHolds ( *p, C ) )
+			Instances.insert(*p);
+
+	for ( i_iterator pi = i_begin(), pi_end = i_end(); pi != pi_end; ++pi )
+		if ( Instances.count(resolveSynonym(static_cast<const TIndividual*>(*pi))) > 0 )
+			Result.push_back(*pi);
+
+	nRetrievalIndividuals += nInd;
+	nRetrievalMerged += nNonInstances + nInstances;
+	nRetrievalParallelTests += nParallel;
+	nRetrievalDroppedTests += nDropped;
+
+	if ( LLM.isWritable(llAlways) )
+		LL << "\nInstance retrieval of '" << C->getName() << "': " << nNonInstances << " non-instances and "
+		   << nInstances << " instances of " << nInd << " individuals were found by model merging ("
+		   << ( nInd > 0 ? (nNonInstances+nInstances)*100/nInd : 100 ) << "%), " << nCandidates
+		   << " candidates were checked by tableau (" << nParallel << " of them in parallel, " << nDropped
+		   << " failed in the threads and re-checked serially)";
+}
+
+void
+TBox :: setELFReasoner ( ELFReasoner* reasoner )
+{
+	delete pELFReasoner;
+	pELFReasoner = reasoner;
+	if ( pELFReasoner != NULL && LLM.isWritable(llAlways) )
+		pELFReasoner->printStatistics(LL);
+}
+
+bool
+TBox :: isELFComplete ( const TConcept* C ) const
+{
+	if ( pELFReasoner == NULL || C->isSingleton() || C->getEntity() == NULL )
+		return false;
+	return pELFReasoner->isComplete(C->getEntity());
+}
+
+bool
+TBox :: isELFUnsatisfiable ( const TConcept* C ) const
+{
+	fpp_assert ( isELFComplete(C) );
+	return pELFReasoner->isUnsatisfiable(C->getEntity());
+}
+
+bool
+TBox :: isELFSubHolds ( const TConcept* C, const TConcept* D ) const
+{
+	fpp_assert ( isELFComplete(C) && D->getEntity() != NULL );
+	return pELFReasoner->isSubsumedBy ( C->getEntity(), D->getEntity() );
+}
+
 /// check that 2 individuals are the same
 bool TBox :: isSameIndividuals ( const TIndividual* a, const TIndividual* b )
 {
@@ -371,6 +678,7 @@ bool TBox :: isSameIndividuals ( const TIndividual* a, const TIndividual* b )
 		return true;
 	if ( !isIndividual(a) || !isIndividual(b) )
 		throw EFaCTPlusPlus("Individuals are expected in the isSameIndividuals() query");
+	registerABoxComponents();	// nominal nodes of the unchecked components are not there yet
 	if ( a->node == NULL || b->node == NULL )	// fresh individuals couldn't be the same
 		return false;
 	return a->getTaxVertex() == b->getTaxVertex();
@@ -412,6 +720,43 @@ TBox :: isIrreflexive ( const TRole* R )
 	return result;
 }
 
+/// @return true iff the role assertions closed under hierarchy and transitivity are all the entailed ones
+bool
+TBox :: isRelatedIndexComplete ( void ) const
+{
+	// nominals and number restrictions could merge individuals; Self and top role add new edges
+	if ( nNominalReferences > 0 || hasNR(KBFeatures) || KBFeatures.hasSelfRef() || KBFeatures.hasTopRole() )
+		return false;
+
+	// functional and reflexive roles and role chains lead to the same problems
+	for ( RoleMaster::const_iterator p = ORM.begin(), p_end = ORM.end(); p != p_end; ++p )
+		if ( !(*p)->isSynonym() && ( (*p)->isFunctional() || (*p)->isReflexive() || (*p)->hasSpecialDomain() ) )
+			return false;
+
+	// same individuals should be reported together
+	for ( i_const_iterator pi = i_begin(); pi != i_end(); ++pi )
+		if ( (*pi)->isSynonym() )
+			return false;
+
+	return true;
+}
+
+/// get the index of the role assertions; build it if necessary
+const TRelatedIndex*
+TBox :: getRelatedIndex ( void )
+{
+	if ( pRelatedIndex == NULL )
+	{
+		pRelatedIndex = new TRelatedIndex();
+		pRelatedIndex->build ( RelatedI, ORM, nC );
+		pRelatedIndex->setComplete(isRelatedIndexComplete());
+		if ( LLM.isWritable(llAlways) )
+			LL << "\nRole assertion index: " << pRelatedIndex->size() << " assertions, "
+			   << (pRelatedIndex->isComplete() ? "complete" : "incomplete") << "\n";
+	}
+	return pRelatedIndex;
+}
+
 // load init values from config file
 void TBox :: readConfig ( const ifOptionSet* Options )
 {
@@ -428,11 +773,13 @@ void TBox :: readConfig ( const ifOptionSet* Options )
 	addBoolOption(dumpQuery);
 	addBoolOption(alwaysPreferEquals);
 	addBoolOption(useSpecialDomains);
+	addBoolOption(useELSaturation);
 	// reasoner's options
 	addBoolOption(useSemanticBranching);
 	addBoolOption(useBackjumping);
 	addBoolOption(useLazyBlocking);
 	addBoolOption(useAnywhereBlocking);
+	addBoolOption(useIncrementalSubsumption);
 
 	if ( Axioms.initAbsorptionFlags(Options->getText("absorptionFlags")) )
 		throw EFaCTPlusPlus ( "Incorrect absorption flags given" );
@@ -441,6 +788,15 @@ void TBox :: readConfig ( const ifOptionSet* Options )
 	if ( LLM.isWritable(llAlways) )
 		LL << "Init testTimeout = " << testTimeout << "\n";
 
+	int nThreads = Options->getInt("classificationThreads");
+	nClassificationThreads = nThreads > 1 ? static_cast<unsigned int>(nThreads) : 1;
+#ifdef _USE_LOGGING
+	// logging is not thread-safe, so use the main thread only
+	nClassificationThreads = 1;
+#endif
+	if ( LLM.isWritable(llAlways) )
+		LL << "Init classificationThreads = " << nClassificationThreads << "\n";
+
 	PriorityMatrix.initPriorities ( Options->getText("IAOEFLG"), "IAOEFLG" );
 
 #ifdef RKG_USE_FAIRNESS
@@ -451,10 +807,30 @@ void TBox :: readConfig ( const ifOptionSet* Options )
 	nSkipBeforeBlock = 0;
 #endif
 
+	int maxKept = Options->getInt("maxKeptGraphSize");
+	maxKeptGraphSize = maxKept > 0 ? static_cast<unsigned int>(maxKept) : 0;
+	if ( LLM.isWritable(llAlways) )
+		LL << "Init maxKeptGraphSize = " << maxKeptGraphSize << "\n";
+
+	int nogoods = Options->getInt("nogoodStoreSize");
+	nogoodStoreSize = nogoods > 0 ? static_cast<unsigned int>(nogoods) : 0;
+	if ( LLM.isWritable(llAlways) )
+		LL << "Init nogoodStoreSize = " << nogoodStoreSize << "\n";
+
 	verboseOutput = false;
 #undef addBoolOption
 }
 
+/// delete all query-related stuff
+void
+TBox :: clearQueryConcept ( void )
+{
+	DLHeap.removeQuery();
+	// the kept model might be built for the removed entries
+	if ( reasonersInited() )
+		stdReasoner->dropKeptModel();
+}
+
 /// create (and DAG-ify) query concept via its definition
 TConcept*
 TBox :: createQueryConcept ( const DLTree* desc )
@@ -501,7 +877,8 @@ TBox :: classifyQueryConcept ( void )
 	fpp_assert ( pTax != NULL );
 	pTaxCreator->setCompletelyDefined(false);	// non-primitive concept
 
-	// classify the concept
+	// classify the concept; all the tests form a single operation
+	TOperationGuard guard(pOperations);
 	pTaxCreator->classifyEntry(pQuery);
 }
 
@@ -523,6 +900,25 @@ TBox :: buildCompletionTree ( const TConcept* pConcept )
 	return ret;
 }
 
+/// add the total reasoning statistic of all the reasoners and of the classification to VALUES
+void
+TBox :: getReasoningStatistic ( std::map<std::string, unsigned long>& values ) const
+{
+	if ( nomReasoner )
+		nomReasoner->getTotalStatistic(values);
+	if ( stdReasoner )
+		stdReasoner->getTotalStatistic(values);
+	if ( pTaxCreator )
+		pTaxCreator->getStatistic(values);
+	if ( nRetrievalIndividuals > 0 )
+	{
+		values["nRetrievalIndividuals"] += nRetrievalIndividuals;
+		values["nRetrievalMerged"] += nRetrievalMerged;
+		values["nRetrievalParallelTests"] += nRetrievalParallelTests;
+		values["nRetrievalDroppedTests"] += nRetrievalDroppedTests;
+	}
+}
+
 /// dump QUERY processing time, reasoning statistics and a (preprocessed) TBox
 void
 TBox :: writeReasoningResult ( std::ostream& o, float time ) const
@@ -33,10 +33,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "ifOptions.h"
 #include "PriorityMatrix.h"
 #include "tRelated.h"
+#include "tRelatedIndex.h"
 #include "tNECollection.h"
 #include "tAxiomSet.h"
 #include "DataTypeCenter.h"
 #include "tProgressMonitor.h"
+#include "tCancelToken.h"
+#include "eFPPTimeout.h"
+#include "eFPPCancelled.h"
 #include "tKBFlags.h"
 #include "tSplitVars.h"
 #include "tSplitExpansionRules.h"
@@ -44,6 +48,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 class DlSatTester;
 class Taxonomy;
 class DLConceptTaxonomy;
+class ELFReasoner;
+class TCostProfile;
+class TCostMeter;
+class TABoxPartition;
 class dumpInterface;
 class TSignature;
 class SaveLoadManager;
@@ -65,6 +73,11 @@ class TBox
 	friend class ReasoningKernel;
 	friend class TAxiom;	// FIXME!! while TConcept can't get rid of told cycles
 	friend class DLConceptTaxonomy;
+	friend class ParallelSubTester;
+	friend class ParallelCacheBuilder;
+	friend class ParallelABoxChecker;
+	friend class ParallelInstanceChecker;
+	friend class TABoxPartition;
 
 public:		// type interface
 		/// vector of CONCEPT-like elements
@@ -166,6 +179,8 @@ protected:	// members
 
 		/// progress monitor
 	TProgressMonitor* pMonitor;
+		/// control of the reasoning operations; allows other threads to cancel them
+	TOperationControl* pOperations;
 
 		/// vectors for Completely defined, Non-CD and Non-primitive concepts
 	ConceptVector arrayCD, arrayNoCD, arrayNP;
@@ -173,8 +188,12 @@ protected:	// members
 	Taxonomy* pTax;
 		/// classifier
 	DLConceptTaxonomy* pTaxCreator;
+		/// EL saturation of the ontology (if any)
+	ELFReasoner* pELFReasoner;
 		/// name-signature map
 	NameSigMap* pName2Sig;
+		/// costs of the concept tests (if they are recorded)
+	TCostProfile* pCostProfile;
 		/// DataType center
 	DataTypeCenter DTCenter;
 		/// set of reasoning options
@@ -216,6 +235,14 @@ protected:	// members
 	TAxiomSet Axioms;
 		/// given individual-individual relations
 	RelatedCollection RelatedI;
+		/// index of the role assertions; built on demand after realisation
+	TRelatedIndex* pRelatedIndex;
+		/// partition of the ABox into independent components; NULL if the whole ABox is reasoned at once
+	TABoxPartition* pABoxPartition;
+		/// individuals whose assertions were changed since the last consistent state; NULL means all of them
+	const std::set<const TNamedEntity*>* pChangedIndividuals;
+		/// consistent components of the ABox partition whose individuals have neither caches nor merges yet
+	std::vector<unsigned int> UnregisteredComponents;
 		/// known disjoint sets of individuals
 	DifferentIndividuals Different;
 		/// all simple rules in KB
@@ -265,6 +292,16 @@ protected:	// members
 	ToDoPriorMatrix PriorityMatrix;
 		/// single SAT/SUB test timeout in milliseconds
 	unsigned long testTimeout;
+		/// number of threads used for the subsumption tests during classification
+	unsigned int nClassificationThreads;
+		/// number of the individuals looked through by the instance retrieval
+	unsigned long nRetrievalIndividuals;
+		/// number of the individuals whose membership was decided by the model merging during the instance retrieval
+	unsigned long nRetrievalMerged;
+		/// number of the instance retrieval candidates checked by the tableau in the worker threads
+	unsigned long nRetrievalParallelTests;
+		/// number of the instance retrieval candidates the worker threads failed to check (re-checked by the main thread)
+	unsigned long nRetrievalDroppedTests;
 
 	//---------------------------------------------------------------------------
 	// Reasoner's members: there are many reasoner classes, some members are shared
@@ -284,6 +321,12 @@ protected:	// members
 	bool duringClassification;
 		/// how many nodes skip before block; work only with FAIRNESS
 	int nSkipBeforeBlock;
+		/// number of completion graph nodes kept by the reasoner after a larger test; 0 means keep all
+	unsigned int maxKeptGraphSize;
+		/// number of nogoods kept by the reasoner during a single test; 0 means no nogood learning
+	unsigned int nogoodStoreSize;
+		/// flag to run the subsumption tests over the kept model of the subsumee
+	bool useIncrementalSubsumption;
 
 	//---------------------------------------------------------------------------
 	// User-defined flags
@@ -299,6 +342,8 @@ protected:	// members
 	bool alwaysPreferEquals;
 		/// use special domains as GCIs
 	bool useSpecialDomains;
+		/// classify the concepts with EL \bot-modules by the EL saturation
+	bool useELSaturation;
 		/// shall verbose output be used
 	bool verboseOutput;
 
@@ -710,8 +755,20 @@ protected:	// methods
 		else
 			return stdReasoner;
 	}
+		/// start measuring the cost of a test made by the current reasoner (if the costs are recorded)
+	void startCost ( TCostMeter& meter ) const;
+		/// finish measuring the cost of a test of the concept C; record the cost (if the costs are recorded)
+	void finishCost ( TCostMeter& meter, const TConcept* C ) const;
 		/// check whether KB is consistent; @return true if it is
 	bool performConsistencyCheck ( void );	// implemented in Reasoner.h
+		/// check whether the ABox is consistent; split it into independent components if possible
+	bool checkABox ( void );
+		/// check the (changed) components of the ABox partition; @return true if they are consistent
+	bool checkABoxComponents ( void );
+		/// @return true iff the component I of the ABox partition contains changed individuals
+	bool isChangedComponent ( unsigned int i ) const;
+		/// make the caches and merges of the individuals of the components that were not checked
+	void registerABoxComponents ( void );
 
 //-----------------------------------------------------------------------------
 //--		internal reasoning interface
@@ -723,6 +780,12 @@ protected:	// methods
 	void initTaxonomy ( void );				// implemented in DLConceptTaxonomy.h
 		/// set NameSigMap
 	void setNameSigMap ( NameSigMap* p ) { pName2Sig = p; }
+		/// set the profile to record the costs of the concept tests; NULL means no recording
+	void setCostProfile ( TCostProfile* p ) { pCostProfile = p; }
+		/// set the individuals changed since the last consistent state; NULL means all of them
+	void setChangedIndividuals ( const std::set<const TNamedEntity*>* p ) { pChangedIndividuals = p; }
+		/// make the nominal cloud contain the individuals among P and Q; the whole ABox is used if there are none
+	void prepareNominalCloud ( const TConcept* p, const TConcept* q );
 		/// creating taxonomy for given TBox; include individuals if necessary
 	void createTaxonomy ( bool needIndividuals );
 		/// distribute all elements in [begin,end) range wtr theif tags
@@ -910,15 +973,19 @@ protected:	// methods
 		KBFeatures |= p->negFeatures;
 		clearRelevanceInfo();
 	}
-		/// update AUX features with the given one; update roles if necessary
-	void updateAuxFeatures ( const LogicFeatures& lf )
+		/// update features TO with the given one LF; update roles if necessary
+	static void updateFeatures ( LogicFeatures& to, const LogicFeatures& lf )
 	{
 		if ( !lf.empty() )
 		{
-			auxFeatures |= lf;
-			auxFeatures.mergeRoles();
+			to |= lf;
+			to.mergeRoles();
 		}
 	}
+		/// update AUX features with the given one; update roles if necessary
+	void updateAuxFeatures ( const LogicFeatures& lf ) { updateFeatures ( auxFeatures, lf ); }
+		/// fill LF with features for SAT(P), or SUB(P,Q) test; doesn't change the TBox
+	void fillQueryFeatures ( LogicFeatures& lf, const TConcept* pConcept, const TConcept* qConcept ) const;
 		/// prepare features for SAT(P), or SUB(P,Q) test
 	void prepareFeatures ( const TConcept* pConcept, const TConcept* qConcept );
 		/// clear current features
@@ -1144,12 +1211,11 @@ public:
 		else
 			return KBFeatures.hasInverseRole();
 	}
+		/// check if given features contains number restrictions
+	static bool hasNR ( const LogicFeatures& lf )
+		{ return lf.hasFunctionalRestriction() || lf.hasNumberRestriction() || lf.hasQNumberRestriction(); }
 		/// check if the relevant part of KB contains number restrictions.
-	bool isNRinQuery ( void ) const
-	{
-		const LogicFeatures* p = curFeature ? curFeature : &KBFeatures;
-		return p->hasFunctionalRestriction() || p->hasNumberRestriction() || p->hasQNumberRestriction();
-	}
+	bool isNRinQuery ( void ) const { return hasNR ( curFeature ? *curFeature : KBFeatures ); }
 		/// check if the relevant part of KB contains singletons
 	bool testHasNominals ( void ) const
 	{
@@ -1214,6 +1280,21 @@ public:
 	void setProgressMonitor ( TProgressMonitor* pMon ) { pMonitor = pMon; }
 		/// check that reasoning progress was cancelled by external application
 	bool isCancelled ( void ) const { return pMonitor != NULL && pMonitor->isCancelled(); }
+		/// set the control of the reasoning operations that allows other threads to cancel them
+	void setOperationControl ( TOperationControl* control ) { pOperations = control; }
+		/// get the control of the reasoning operations (if any)
+	TOperationControl* getOperationControl ( void ) const { return pOperations; }
+		/// throw an exception if the operation the thread works for is cancelled or its wall-clock time is over
+	void checkInterrupt ( void ) const
+	{
+		const TCancelToken* token = TCancelToken::getCurrent();
+		if ( token == NULL )
+			return;
+		if ( token->isCancelled() )
+			throw EFPPCancelled();
+		if ( token->isTimedOut() )
+			throw EFPPTimeout();
+	}
 		/// set verbose output (ie, default progress monitor, concept and role taxonomies) wrt given VALUE
 	void setVerboseOutput ( bool value ) { verboseOutput = value; }
 
@@ -1224,7 +1305,7 @@ public:
 		/// classify query concept
 	void classifyQueryConcept ( void );
 		/// delete all query-related stuff
-	void clearQueryConcept ( void ) { DLHeap.removeQuery(); }
+	void clearQueryConcept ( void );
 
 //-----------------------------------------------------------------------------
 //--		public reasoning interface
@@ -1253,12 +1334,31 @@ public:
 	bool isSubHolds ( const TConcept* C, const TConcept* D );
 		/// check if a concept C is satisfiable
 	bool isSatisfiable ( const TConcept* C );
+		/// set RESULT into the instances of the concept C; the tableau is used only if the model merging fails
+	void retrieveInstances ( const TConcept* C, TIndividual::CIVec& Result );
+
+		/// @return true iff the EL saturation should be built before the classification
+	bool needELFReasoner ( void ) const { return useELSaturation && pELFReasoner == NULL && pTax == NULL; }
+		/// set the EL saturation of the ontology; the TBox takes the ownership of it
+	void setELFReasoner ( ELFReasoner* reasoner );
+		/// @return true iff all the subsumers of a concept C are known from the EL saturation
+	bool isELFComplete ( const TConcept* C ) const;
+		/// @return true iff the EL-complete concept C is unsatisfiable
+	bool isELFUnsatisfiable ( const TConcept* C ) const;
+		/// @return true iff the EL-complete concept C is subsumed by the named concept D
+	bool isELFSubHolds ( const TConcept* C, const TConcept* D ) const;
 		/// check that 2 individuals are the same
 	bool isSameIndividuals ( const TIndividual* a, const TIndividual* b );
 		/// check if 2 roles are disjoint
 	bool isDisjointRoles ( const TRole* R, const TRole* S );
 		/// check if the role R is irreflexive
 	bool isIrreflexive ( const TRole* R );
+		/// @return true iff the role assertions closed under hierarchy and transitivity are all the entailed ones
+	bool isRelatedIndexComplete ( void ) const;
+		/// get the index of the role assertions; build it if necessary
+	const TRelatedIndex* getRelatedIndex ( void );
+		/// clear the index of the role assertions
+	void clearRelatedIndex ( void ) { delete pRelatedIndex; pRelatedIndex = NULL; }
 
 		/// fills cache entry for given concept; SUB means that the concept is on the right side of a subsumption test
 	const modelCacheInterface* initCache ( const TConcept* pConcept, bool sub = false );
@@ -1292,6 +1392,8 @@ public:
 
 		/// dump query processing TIME, reasoning statistics and a (preprocessed) TBox
 	void writeReasoningResult ( std::ostream& o, float time ) const;
+		/// add the total reasoning statistic of all the reasoners and of the classification to VALUES
+	void getReasoningStatistic ( std::map<std::string, unsigned long>& values ) const;
 		/// print TBox as a whole
 	void Print ( std::ostream& o ) const
 	{
@@ -1,5 +1,5 @@
 /* This file is part of the FaCT++ DL reasoner
-Copyright (C) 2006-2009 by Dmitry Tsarkov
+Copyright (C) 2006-2014 by Dmitry Tsarkov
 
 This library is free software; you can redistribute it and/or
 modify it under the terms of the GNU Lesser General Public
@@ -19,50 +19,95 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef _DLVHASH_H
 #define _DLVHASH_H
 
-#include <map>
-#include <list>
+#include <vector>
 #include "dlVertex.h"
 #include "tRole.h"
 
-/// naive and simple hash table for DL Verteces
+/**
+ *	Hash table for DL Verteces. The table uses open addressing with linear
+ *	probing over a single array, so the lookup does not allocate memory and
+ *	touches only a few neighbour entries. Every entry keeps the hash value
+ *	of the vertex, so the vertices themselves are compared only when hashes
+ *	are equal and the table could be grown without rehashing.
+ */
 class dlVHashTable
 {
 protected:	// types
-		/// hashed IDs of the DL verteces
-	typedef std::list<BipolarPointer> HashLeaf;
+		/// hash value of a vertex
+	typedef unsigned int HashValue;
+		/// entry of the table: vertex position in the DAG and its hash value
+	struct HashEntry
+	{
+			/// hash value of the vertex
+		HashValue hash;
+			/// position of the vertex in the DAG; bpINVALID for the empty entry
+		BipolarPointer pos;
+			/// empty c'tor
+		HashEntry ( void ) : hash(0), pos(bpINVALID) {}
+	}; // HashEntry
 		/// hash table by itself
-	typedef std::map<BipolarPointer, HashLeaf> HashTable;
+	typedef std::vector<HashEntry> HashTable;
 
 protected:	// members
 		/// host DAG that contains actual nodes;
 	const DLDag& host;
-		/// HT for nodes
+		/// HT for nodes; its size is either 0 or a power of 2
 	HashTable Table;
+		/// number of the elements in the table
+	size_t nElems;
 
 protected:	// methods
-		/// get a (very simple) hash of the vertex
-	static BipolarPointer hash ( const DLVertex& v )
+		/// rotate X left by R bits
+	static HashValue rotl ( HashValue x, unsigned int r ) { return (x << r) | (x >> (32 - r)); }
+		/// mix value K into the hash H (MurmurHash3 body step)
+	static HashValue mix ( HashValue h, HashValue k )
+	{
+		k *= 0xcc9e2d51u;
+		k = rotl(k,15);
+		k *= 0x1b873593u;
+		h ^= k;
+		h = rotl(h,13);
+		return h*5 + 0xe6546b64u;
+	}
+		/// final avalanche of the hash H (MurmurHash3 finaliser)
+	static HashValue finalise ( HashValue h )
 	{
-		BipolarPointer sum = 0;
-		if ( v.getRole() != NULL )
-			sum += v.getRole()->getId();
-		if ( v.getProjRole() != NULL )
-			sum += v.getProjRole()->getId();
-		sum += v.getC();
-		sum += v.getNumberLE();
+		h ^= h >> 16;
+		h *= 0x85ebca6bu;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35u;
+		h ^= h >> 16;
+		return h;
+	}
+		/// get a hash of the vertex; uses all the fields compared by the DLVertex::operator ==
+	static HashValue hash ( const DLVertex& v )
+	{
+		HashValue h = mix ( 0, v.Type() );
+		h = mix ( h, v.getRole() ? v.getRole()->getId() : 0 );
+		h = mix ( h, v.getProjRole() ? v.getProjRole()->getId() : 0 );
+		h = mix ( h, v.getC() );
+		h = mix ( h, v.getNumberLE() );
 		for ( DLVertex::const_iterator p = v.begin(), p_end = v.end(); p < p_end; ++p )
-			sum += *p;
-		return sum;
+			h = mix ( h, *p );
+		return finalise ( h ^ static_cast<HashValue>(v.end() - v.begin()) );
 	}
 
-		/// insert new POSition into a given LEAF
-	void insert ( HashLeaf& leaf, BipolarPointer pos ) { leaf.push_back(pos); }
-		/// locate vertex V in a given LEAF
-	BipolarPointer locate ( const HashLeaf& leaf, const DLVertex& v ) const;
+		/// @return the mask for the table indices
+	size_t mask ( void ) const { return Table.size() - 1; }
+		/// put an entry E to the table that has at least one free entry
+	void insert ( const HashEntry& e )
+	{
+		size_t i = e.hash & mask();
+		while ( Table[i].pos != bpINVALID )
+			i = (i+1) & mask();
+		Table[i] = e;
+	}
+		/// double the size of the table
+	void grow ( void );
 
 public:		// interface
 		/// empty c'tor
-	dlVHashTable ( const DLDag& dag ) : host(dag) {}
+	dlVHashTable ( const DLDag& dag ) : host(dag), nElems(0) {}
 		/// empty d'tor
 	~dlVHashTable ( void ) {}
 
@@ -1,5 +1,5 @@
 /* This file is part of the FaCT++ DL reasoner
-Copyright (C) 2006-2008 by Dmitry Tsarkov
+Copyright (C) 2006-2014 by Dmitry Tsarkov
 
 This library is free software; you can redistribute it and/or
 modify it under the terms of the GNU Lesser General Public
@@ -21,28 +21,41 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 // implementation of DLVertex Hash; to be included after DLDag definition
 
-inline BipolarPointer
-dlVHashTable :: locate ( const HashLeaf& leaf, const DLVertex& v ) const
+inline void
+dlVHashTable :: grow ( void )
 {
-	for ( HashLeaf::const_iterator p = leaf.begin(), p_end = leaf.end(); p != p_end; ++p )
-		if ( v == host[*p] )
-			return *p;
-
-	return bpINVALID;
+	HashTable old ( Table.empty() ? 64 : Table.size()*2 );
+	Table.swap(old);
+	for ( HashTable::const_iterator p = old.begin(), p_end = old.end(); p != p_end; ++p )
+		if ( p->pos != bpINVALID )
+			insert(*p);
 }
 
 inline BipolarPointer
 dlVHashTable :: locate ( const DLVertex& v ) const
 {
-	HashTable::const_iterator p = Table.find(hash(v));
-	return p == Table.end() ? bpINVALID : locate ( p->second, v );
+	if ( nElems == 0 )
+		return bpINVALID;
+
+	HashValue h = hash(v);
+	for ( size_t i = h & mask(); Table[i].pos != bpINVALID; i = (i+1) & mask() )
+		if ( Table[i].hash == h && v == host[Table[i].pos] )
+			return Table[i].pos;
+
+	return bpINVALID;
 }
 
 inline void
 dlVHashTable :: addElement ( BipolarPointer pos )
 {
-	insert ( Table[hash(host[pos])], pos );
+	// keep the load factor below 1/2 to have short probe sequences
+	if ( 2*(nElems+1) > Table.size() )
+		grow();
+	HashEntry e;
+	e.hash = hash(host[pos]);
+	e.pos = pos;
+	insert(e);
+	++nElems;
 }
 
 #endif
-
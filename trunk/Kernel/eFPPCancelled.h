@@ -0,0 +1,30 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef EFPPCANCELLED_H
+#define EFPPCANCELLED_H
+
+#include "eFaCTPlusPlus.h"
+
+class EFPPCancelled: public EFaCTPlusPlus
+{
+public:		// interface
+	EFPPCancelled ( void ) : EFaCTPlusPlus("FaCT++ Kernel: operation cancelled") {}
+}; // EFPPCancelled
+
+#endif
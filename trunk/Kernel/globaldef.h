@@ -50,6 +50,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #	define RKG_IMPROVE_SAVE_RESTORE_DEPSET
 #endif
 
+// uncomment this to use list-based dep-sets for all the levels (instead of bit-vectors for the first 64 ones)
+//#define RKG_USE_LIST_DEPSET
+
 // uncomment this to update role's R&D from super-roles
 //#define RKG_UPDATE_RND_FROM_SUPERROLES
 
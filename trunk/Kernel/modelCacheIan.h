@@ -22,7 +22,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include "modelCacheSingleton.h"
 #include "dlCompletionTree.h"
 #include "dlDag.h"
-#include "tSetAsTree.h"
+#include "tSetAsHybrid.h"
 
 class SaveLoadManager;
 
@@ -35,7 +35,7 @@ class modelCacheIan: public modelCacheInterface
 friend class DLConceptTaxonomy;
 protected:	// types
 		/// define the type of an index set
-	typedef TSetAsTree IndexSet;
+	typedef TSetAsHybrid IndexSet;
 		/// node label iterator
 	typedef DlCompletionTree::const_label_iterator l_iterator;
 		/// edges iterator
@@ -20,6 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #define PROCTIMER_H
 
 #include <time.h>
+#include <sys/time.h>
 
 /**
   * Class TsProcTimer definition & implementation
@@ -119,4 +120,115 @@ inline void TsProcTimer :: Stop ( void )
 	}
 }
 
+/**
+  * Class TsWallTimer: the same as TsProcTimer, but measures the elapsed
+  * (wall-clock) time, which does not depend on the number of running threads
+  */
+class TsWallTimer
+{
+private:	// members
+		/// save the starting time of the timer
+	struct timeval startTime;
+		/// calculated time between Start() and Stop() calls
+	float resultTime;
+		/// flag to show timer is started
+	bool Started;
+
+private:	// methods
+		/// get time interval between startTime and current time
+	float calcDelta ( void ) const
+	{
+		struct timeval finishTime;
+		gettimeofday ( &finishTime, NULL );
+		return float(finishTime.tv_sec-startTime.tv_sec) + float(finishTime.tv_usec-startTime.tv_usec)/1e6f;
+	}
+
+public:		// interface
+		/// the only c'tor
+	TsWallTimer ( void ) : resultTime(0.0), Started(false) { startTime.tv_sec = 0; startTime.tv_usec = 0; }
+		/// empty d'tor
+	~TsWallTimer ( void ) {}
+
+		/// reset timer
+	void Reset ( void ) { Started = false; resultTime = 0; }
+
+		/// record current time
+	void Start ( void )
+	{
+		if ( !Started )
+		{
+			gettimeofday ( &startTime, NULL );
+			Started = true;
+		}
+	}
+		/// save time interval from starting point to current moment
+	void Stop ( void )
+	{
+		if ( Started )
+		{
+			Started = false;
+			resultTime += calcDelta();
+		}
+	}
+
+		/// get time interval
+	operator float ( void ) const { return Started ? resultTime + calcDelta() : resultTime; }
+}; // TsWallTimer
+
+/**
+  * Class TsThreadTimer: the same as TsProcTimer, but measures the processor
+  * time of the calling thread only, so the time of the other threads is not
+  * counted; all the calls should be made from the same thread
+  */
+class TsThreadTimer
+{
+private:	// members
+		/// save the starting time of the timer
+	struct timespec startTime;
+		/// calculated time between Start() and Stop() calls
+	float resultTime;
+		/// flag to show timer is started
+	bool Started;
+
+private:	// methods
+		/// get time interval between startTime and current time
+	float calcDelta ( void ) const
+	{
+		struct timespec finishTime;
+		clock_gettime ( CLOCK_THREAD_CPUTIME_ID, &finishTime );
+		return float(finishTime.tv_sec-startTime.tv_sec) + float(finishTime.tv_nsec-startTime.tv_nsec)/1e9f;
+	}
+
+public:		// interface
+		/// the only c'tor
+	TsThreadTimer ( void ) : resultTime(0.0), Started(false) { startTime.tv_sec = 0; startTime.tv_nsec = 0; }
+		/// empty d'tor
+	~TsThreadTimer ( void ) {}
+
+		/// reset timer
+	void Reset ( void ) { Started = false; resultTime = 0; }
+
+		/// record current time
+	void Start ( void )
+	{
+		if ( !Started )
+		{
+			clock_gettime ( CLOCK_THREAD_CPUTIME_ID, &startTime );
+			Started = true;
+		}
+	}
+		/// save time interval from starting point to current moment
+	void Stop ( void )
+	{
+		if ( Started )
+		{
+			Started = false;
+			resultTime += calcDelta();
+		}
+	}
+
+		/// get time interval
+	operator float ( void ) const { return Started ? resultTime + calcDelta() : resultTime; }
+}; // TsThreadTimer
+
 #endif
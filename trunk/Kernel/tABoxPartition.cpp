@@ -0,0 +1,83 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "tABoxPartition.h"
+#include "dlTBox.h"
+
+/// @return the representative of the set containing X; compress the path to it
+static unsigned int
+findRoot ( std::vector<unsigned int>& Parent, unsigned int x )
+{
+	unsigned int root = x;
+	while ( Parent[root] != root )
+		root = Parent[root];
+	while ( Parent[x] != root )
+	{
+		unsigned int next = Parent[x];
+		Parent[x] = root;
+		x = next;
+	}
+	return root;
+}
+
+TABoxPartition :: TABoxPartition ( TBox& kb )
+{
+	// number all the individuals
+	SingletonVector Inds;
+	for ( TBox::i_iterator pi = kb.i_begin(), pi_end = kb.i_end(); pi != pi_end; ++pi )
+		if ( !(*pi)->isSynonym() )
+		{
+			Index[*pi] = Inds.size();
+			Inds.push_back(*pi);
+		}
+
+	// join the sets connected by the role assertions; the second assertion of every pair is the inverse one
+	std::vector<unsigned int> Parent;
+	for ( unsigned int i = 0; i < Inds.size(); ++i )
+		Parent.push_back(i);
+	for ( TBox::RelatedCollection::const_iterator q = kb.RelatedI.begin(), q_end = kb.RelatedI.end(); q != q_end; ++q, ++q )
+	{
+		unsigned int a = findRoot ( Parent, Index[resolveSynonym((*q)->a)] );
+		unsigned int b = findRoot ( Parent, Index[resolveSynonym((*q)->b)] );
+		if ( a != b )
+			Parent[b] = a;
+	}
+
+	// number the components in the order of their first individuals
+	std::vector<unsigned int> CompOf ( Inds.size(), 0 );
+	std::map<unsigned int, unsigned int> RootComp;
+	for ( unsigned int i = 0; i < Inds.size(); ++i )
+	{
+		unsigned int root = findRoot ( Parent, i );
+		std::map<unsigned int, unsigned int>::iterator found = RootComp.find(root);
+		if ( found == RootComp.end() )
+		{
+			found = RootComp.insert(std::make_pair(root,static_cast<unsigned int>(Components.size()))).first;
+			Components.push_back(Component());
+		}
+		CompOf[i] = found->second;
+		Components[CompOf[i]].Individuals.push_back(Inds[i]);
+	}
+	for ( TBox::RelatedCollection::const_iterator q = kb.RelatedI.begin(), q_end = kb.RelatedI.end(); q != q_end; ++q, ++q )
+		Components[CompOf[Index[resolveSynonym((*q)->a)]]].Related.push_back(*q);
+
+	// Index now maps individuals to their components
+	for ( unsigned int i = 0; i < Inds.size(); ++i )
+		Index[Inds[i]] = CompOf[i];
+}
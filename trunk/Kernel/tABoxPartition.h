@@ -0,0 +1,85 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef TABOXPARTITION_H
+#define TABOXPARTITION_H
+
+#include <map>
+#include <vector>
+
+class TBox;
+class TIndividual;
+class TRelated;
+
+/**
+ *	Partition of the ABox into the connected components. Two individuals
+ *	are in the same component iff they are connected by the role assertions
+ *	(in any direction). The role hierarchy, inverses, transitivity and role
+ *	chains only add edges between the connected individuals, so the
+ *	components are independent wrt a TBox without nominals and the top
+ *	role. The same-individual assertions are taken into account via the
+ *	synonyms; the different-individual ones do not connect individuals.
+ */
+class TABoxPartition
+{
+public:		// types
+		/// vector of individuals
+	typedef std::vector<TIndividual*> SingletonVector;
+		/// vector of role assertions
+	typedef std::vector<TRelated*> RelatedVector;
+		/// single component of the ABox
+	struct Component
+	{
+			/// individuals of the component
+		SingletonVector Individuals;
+			/// role assertions between the individuals (one of each inverse pair)
+		RelatedVector Related;
+	}; // Component
+
+protected:	// members
+		/// all the components
+	std::vector<Component> Components;
+		/// map between the individuals and the indices of their components
+	std::map<const TIndividual*, unsigned int> Index;
+
+private:	// no copy
+		/// no copy c'tor
+	TABoxPartition ( const TABoxPartition& );
+		/// no assignment
+	TABoxPartition& operator = ( const TABoxPartition& );
+
+public:		// interface
+		/// c'tor: split the ABox of KB into components
+	explicit TABoxPartition ( TBox& kb );
+		/// empty d'tor
+	~TABoxPartition ( void ) {}
+
+		/// get number of the components
+	unsigned int size ( void ) const { return Components.size(); }
+		/// get the component number I
+	const Component& operator[] ( unsigned int i ) const { return Components[i]; }
+		/// @return index of the component of the (synonym-resolved) individual IND; size() if it is unknown
+	unsigned int getComponent ( const TIndividual* ind ) const
+	{
+		std::map<const TIndividual*, unsigned int>::const_iterator p = Index.find(ind);
+		return p == Index.end() ? size() : p->second;
+	}
+}; // TABoxPartition
+
+#endif
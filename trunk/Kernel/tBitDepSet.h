@@ -0,0 +1,153 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TBITDEPSET_H
+#define TBITDEPSET_H
+
+#include "globaldef.h"
+#include "tDepSet.h"
+
+/**
+ *	dep-set implementation that keeps the levels below 64 as a bit-vector,
+ *	so the union of shallow dep-sets is a single OR. Deeper levels are kept
+ *	in a list-based dep-set.
+ */
+class TBitDepSet
+{
+protected:	// types
+		/// type of the bit-vector
+	typedef unsigned long long BitVector;
+
+protected:	// members
+		/// levels [0,nBits) of the dep-set
+	BitVector Shallow;
+		/// levels [nBits,...) of the dep-set
+	TDepSet Deep;
+
+protected:	// methods
+		/// number of levels kept in the bit-vector
+	static unsigned int nBits ( void ) { return sizeof(BitVector)*8; }
+		/// @return bit that corresponds to a LEVEL
+	static BitVector bit ( unsigned int level ) { return BitVector(1) << level; }
+		/// @return the largest level in the (non-empty) bit-vector
+	static unsigned int maxLevel ( BitVector bits )
+	{
+#	if defined(__GNUC__) && (__GNUC__ >= 4)
+		return nBits() - 1 - __builtin_clzll(bits);
+#	else
+		unsigned int ret = 0;
+		while ( bits >>= 1 )
+			++ret;
+		return ret;
+#	endif
+	}
+
+public:		// interface
+		/// default c'tor: create empty dep-set
+	TBitDepSet ( void ) : Shallow(0) {}
+		/// main c'tor: create a dep-set with all the levels of DEPP
+	explicit TBitDepSet ( TDepSetElement* depp ) : Shallow(0)
+	{
+		for ( TDepSetElement* p = depp; p; p = p->tail() )
+			if ( p->level() < nBits() )
+				Shallow |= bit(p->level());
+			else	// deep levels are rare: add them one by one
+				Deep.add(TDepSet(p->getManager()->get(p->level())));
+	}
+		/// copy c'tor
+	TBitDepSet ( const TBitDepSet& d ) : Shallow(d.Shallow), Deep(d.Deep) {}
+		/// assignment
+	TBitDepSet& operator = ( const TBitDepSet& d ) { Shallow = d.Shallow; Deep = d.Deep; return *this; }
+		/// empty d'tor
+	~TBitDepSet ( void ) {}
+
+	// access methods
+
+		/// return latest branching point in the dep-set
+	unsigned int level ( void ) const
+	{
+		if ( unlikely(!Deep.empty()) )
+			return Deep.level();
+		return Shallow ? maxLevel(Shallow) : 0;
+	}
+	 	/// check if the dep-set is empty
+	bool empty ( void ) const { return Shallow == 0 && Deep.empty(); }
+		/// check if the dep-set contains given level
+	bool contains ( unsigned int level ) const
+		{ return level < nBits() ? (Shallow & bit(level)) != 0 : Deep.contains(level); }
+		/// check the equivalence of the two dep-sets
+	bool operator == ( const TBitDepSet& ds ) const { return Shallow == ds.Shallow && Deep == ds.Deep; }
+
+		/// Adds given dep-set to current dep-set
+	void add ( const TBitDepSet& toAdd )
+	{
+		Shallow |= toAdd.Shallow;
+		if ( unlikely(!toAdd.Deep.empty()) )
+			Deep.add(toAdd.Deep);
+	}
+		/// Adds given dep-set to current dep-set
+	TBitDepSet& operator += ( const TBitDepSet& toAdd ) { add(toAdd); return *this; }
+		/// Remove all information from dep-set
+	void clear ( void ) { Shallow = 0; Deep.clear(); }
+		/// remove parts of the current dep-set that larger than given level
+	void restrict ( unsigned int level )
+	{
+		if ( level < nBits() )
+		{
+			Shallow &= bit(level) - 1;
+			Deep.clear();
+		}
+		else
+			Deep.restrict(level);
+	}
+
+		/// add all the levels of the dep-set to LEVELS
+	void getLevels ( std::vector<unsigned int>& levels ) const
+	{
+		for ( BitVector bits = Shallow; bits; bits &= bits-1 )
+			levels.push_back(maxLevel(bits & (~bits+1)));
+		Deep.getLevels(levels);
+	}
+
+		/// Print given dep-set to a standart stream
+	template <class O>
+	void Print ( O& o ) const
+	{
+		if ( empty() )
+			return;
+		o << "{";
+		bool first = true;
+		for ( unsigned int i = 0; i < nBits(); ++i )
+			if ( Shallow & bit(i) )
+			{
+				if ( !first )
+					o << ',';
+				o << i;
+				first = false;
+			}
+		if ( !Deep.empty() )
+		{
+			if ( !first )
+				o << ',';
+			Deep.printLevels(o);
+		}
+		o << "}";
+	}
+}; // TBitDepSet
+
+#endif
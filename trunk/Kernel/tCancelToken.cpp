@@ -0,0 +1,41 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "tCancelToken.h"
+
+/// key of the thread-specific current token
+static pthread_key_t CurrentTokenKey;
+/// control of the single creation of the key
+static pthread_once_t CurrentTokenOnce = PTHREAD_ONCE_INIT;
+
+/// create the key of the current token
+static void createCurrentTokenKey ( void ) { pthread_key_create ( &CurrentTokenKey, NULL ); }
+
+TCancelToken*
+TCancelToken :: getCurrent ( void )
+{
+	pthread_once ( &CurrentTokenOnce, createCurrentTokenKey );
+	return static_cast<TCancelToken*>(pthread_getspecific(CurrentTokenKey));
+}
+
+void
+TCancelToken :: setCurrent ( TCancelToken* token )
+{
+	pthread_once ( &CurrentTokenOnce, createCurrentTokenKey );
+	pthread_setspecific ( CurrentTokenKey, token );
+}
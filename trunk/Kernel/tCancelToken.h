@@ -0,0 +1,176 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TCANCELTOKEN_H
+#define TCANCELTOKEN_H
+
+#include <set>
+
+#include "tMutex.h"
+#include "procTimer.h"
+
+/**
+ *	Control of a single reasoning operation (KB processing or a query). Every
+ *	outermost operation gets its own token, so the operations running in
+ *	different threads have their own deadlines and cancel requests. The token
+ *	is the current one of the thread running the operation and of the worker
+ *	threads serving it; the reasoner polls the current token from time to time.
+ *	Any thread may cancel the operation; the operation may also be limited by
+ *	the wall-clock time, counted from the creation of the token.
+ */
+class TCancelToken
+{
+protected:	// members
+		/// mutex for the cancel request
+	mutable TMutex Mutex;
+		/// wall-clock timer of the operation
+	TsWallTimer Timer;
+		/// wall-clock timeout of the operation in milliseconds; 0 means no timeout
+	const unsigned long Timeout;
+		/// true iff the operation should be stopped
+	bool Cancelled;
+
+private:	// no copy
+		/// no copy c'tor
+	TCancelToken ( const TCancelToken& );
+		/// no assignment
+	TCancelToken& operator = ( const TCancelToken& );
+
+public:		// interface
+		/// c'tor: start an operation with a given wall-clock TIMEOUT
+	explicit TCancelToken ( unsigned long timeout ) : Timeout(timeout), Cancelled(false) { Timer.Start(); }
+		/// empty d'tor
+	~TCancelToken ( void ) {}
+
+		/// ask the operation to stop
+	void cancel ( void ) { TMutexLock Lock(Mutex); Cancelled = true; }
+		/// @return true iff the operation should be stopped
+	bool isCancelled ( void ) const { TMutexLock Lock(Mutex); return Cancelled; }
+		/// @return true iff the operation is out of its time
+	bool isTimedOut ( void ) const { return Timeout > 0 && 1000*(float)Timer >= Timeout; }
+
+		/// get the token of the operation the calling thread works for; NULL if there is none
+	static TCancelToken* getCurrent ( void );
+		/// set the token of the operation the calling thread works for
+	static void setCurrent ( TCancelToken* token );
+}; // TCancelToken
+
+/**
+ *	Tokens of the reasoning operations running in a kernel. Keeps the timeout
+ *	of the new operations and allows any thread to cancel the running ones;
+ *	the operations started after the cancellation are not affected.
+ */
+class TOperationControl
+{
+protected:	// members
+		/// mutex for all the fields
+	mutable TMutex Mutex;
+		/// tokens of the running operations
+	std::set<TCancelToken*> Running;
+		/// wall-clock timeout of an operation in milliseconds; 0 means no timeout
+	unsigned long Timeout;
+
+private:	// no copy
+		/// no copy c'tor
+	TOperationControl ( const TOperationControl& );
+		/// no assignment
+	TOperationControl& operator = ( const TOperationControl& );
+
+public:		// interface
+		/// empty c'tor
+	TOperationControl ( void ) : Timeout(0) {}
+		/// empty d'tor
+	~TOperationControl ( void ) {}
+
+		/// set the wall-clock timeout of the new operations in milliseconds; 0 switches it off
+	void setTimeout ( unsigned long timeout ) { TMutexLock Lock(Mutex); Timeout = timeout; }
+		/// get the wall-clock timeout of the new operations
+	unsigned long getTimeout ( void ) const { TMutexLock Lock(Mutex); return Timeout; }
+
+		/// register a TOKEN of the started operation
+	void add ( TCancelToken* token ) { TMutexLock Lock(Mutex); Running.insert(token); }
+		/// forget a TOKEN of the finished operation
+	void remove ( TCancelToken* token ) { TMutexLock Lock(Mutex); Running.erase(token); }
+		/// ask all the running operations to stop
+	void cancel ( void )
+	{
+		TMutexLock Lock(Mutex);
+		for ( std::set<TCancelToken*>::iterator p = Running.begin(), p_end = Running.end(); p != p_end; ++p )
+			(*p)->cancel();
+	}
+}; // TOperationControl
+
+/// mark the lifetime of the object as a reasoning operation of a CONTROL (if any); the nested operations are parts of the outermost one
+class TOperationGuard
+{
+protected:	// members
+		/// control of the operations
+	TOperationControl* Control;
+		/// token of the operation; NULL if the operation is nested
+	TCancelToken* Token;
+
+private:	// no copy
+		/// no copy c'tor
+	TOperationGuard ( const TOperationGuard& );
+		/// no assignment
+	TOperationGuard& operator = ( const TOperationGuard& );
+
+public:		// interface
+		/// c'tor: start an operation with a fresh token unless the thread is already working for one
+	explicit TOperationGuard ( TOperationControl* control )
+		: Control(control)
+		, Token(NULL)
+	{
+		if ( Control == NULL || TCancelToken::getCurrent() != NULL )
+			return;
+		Token = new TCancelToken(Control->getTimeout());
+		Control->add(Token);
+		TCancelToken::setCurrent(Token);
+	}
+		/// d'tor: finish the operation
+	~TOperationGuard ( void )
+	{
+		if ( Token == NULL )
+			return;
+		TCancelToken::setCurrent(NULL);
+		Control->remove(Token);
+		delete Token;
+	}
+}; // TOperationGuard
+
+/// make a given token the current one of the calling thread for the lifetime of the object; used by the threads serving an operation
+class TCancelTokenScope
+{
+protected:	// members
+		/// token that was current before
+	TCancelToken* Saved;
+
+private:	// no copy
+		/// no copy c'tor
+	TCancelTokenScope ( const TCancelTokenScope& );
+		/// no assignment
+	TCancelTokenScope& operator = ( const TCancelTokenScope& );
+
+public:		// interface
+		/// c'tor: make TOKEN current
+	explicit TCancelTokenScope ( TCancelToken* token ) : Saved(TCancelToken::getCurrent()) { TCancelToken::setCurrent(token); }
+		/// d'tor: restore the previous token
+	~TCancelTokenScope ( void ) { TCancelToken::setCurrent(Saved); }
+}; // TCancelTokenScope
+
+#endif
@@ -0,0 +1,110 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TCONCEPTACTIVITY_H
+#define TCONCEPTACTIVITY_H
+
+#include <vector>
+
+#include "BiPointer.h"
+
+/**
+ *	Activity of the DAG entries in the clashes, in the spirit of the VSIDS
+ *	heuristic of SAT solvers. Every time a disjunct fails its activity is
+ *	bumped by the current increment; the increment grows after every bump,
+ *	so the older clashes weigh less than the recent ones. Ties are broken by
+ *	a hash of the entry and the seed, so the order is reproducible; the zero
+ *	seed makes all the ties equal. Every reasoner has its own activities, so
+ *	the parallel workers learn only from the tests they run themselves.
+ */
+class TConceptActivity
+{
+protected:	// members
+		/// activity of every DAG entry; indexed by the polarised pointer
+	std::vector<double> Activity;
+		/// current activity increment
+	double Inc;
+		/// seed for the tie-breaking
+	unsigned int Seed;
+
+protected:	// methods
+		/// the increment grows by 1/decayFactor() after every bump
+	static double decayFactor ( void ) { return 0.95; }
+		/// rescale all the activities if the increment is larger than that
+	static double rescaleLimit ( void ) { return 1e100; }
+		/// @return index of the activity of the entry P
+	static unsigned int index ( BipolarPointer p ) { return 2*getValue(p) + (isNegative(p) ? 1 : 0); }
+		/// @return the activity of the entry P
+	double get ( BipolarPointer p ) const
+	{
+		unsigned int i = index(p);
+		return i < Activity.size() ? Activity[i] : 0.0;
+	}
+		/// @return the tie-breaking key of the entry P
+	unsigned int tie ( BipolarPointer p ) const
+	{
+		if ( Seed == 0 )
+			return 0;
+		unsigned int h = ( index(p) + 1 ) * 2654435761U ^ Seed;
+		h ^= h >> 16;
+		h *= 0x45d9f3bU;
+		h ^= h >> 16;
+		return h;
+	}
+
+public:		// interface
+		/// empty c'tor
+	TConceptActivity ( void ) : Inc(1.0), Seed(0) {}
+		/// empty d'tor
+	~TConceptActivity ( void ) {}
+
+		/// set the tie-breaking seed
+	void setSeed ( unsigned int seed ) { Seed = seed; }
+		/// forget all the activities
+	void clear ( void )
+	{
+		Activity.clear();
+		Inc = 1.0;
+	}
+
+		/// register a clash of the entry P
+	void bump ( BipolarPointer p )
+	{
+		unsigned int i = index(p);
+		if ( i >= Activity.size() )
+			Activity.resize ( i+1, 0.0 );
+		Activity[i] += Inc;
+		Inc /= decayFactor();
+		if ( Inc > rescaleLimit() )
+		{	// keep the values in range; the order is not changed
+			for ( std::vector<double>::iterator q = Activity.begin(), q_end = Activity.end(); q != q_end; ++q )
+				*q /= rescaleLimit();
+			Inc /= rescaleLimit();
+		}
+	}
+		/// @return true iff P1 was less active in clashes than P2
+	bool less ( BipolarPointer p1, BipolarPointer p2 ) const
+	{
+		double a1 = get(p1), a2 = get(p2);
+		if ( a1 != a2 )
+			return a1 < a2;
+		return tie(p1) < tie(p2);
+	}
+}; // TConceptActivity
+
+#endif
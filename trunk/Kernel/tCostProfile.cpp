@@ -0,0 +1,111 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "tCostProfile.h"
+
+/// header of the cost profile file
+static const char* CostProfileHeader = "FaCT++CostProfile1";
+
+/// replace the known costs with the ones measured in the current run; start a new run
+void
+TCostProfile :: update ( void )
+{
+	// the concepts that were not tested in the current run keep the old costs
+	for ( CostMap::const_iterator p = Current.begin(), p_end = Current.end(); p != p_end; ++p )
+		Known[p->first] = p->second;
+	Current.clear();
+}
+
+/// load known costs from the file FILENAME; @return false if the file can not be read
+bool
+TCostProfile :: load ( const std::string& filename )
+{
+	Known.clear();
+	std::ifstream in(filename.c_str());
+	std::string header;
+	if ( !std::getline ( in, header ) || header != CostProfileHeader )
+		return false;
+
+	// every line is "tests tactics branches time name"; the name is the rest of the line
+	TCostRecord cost;
+	std::string name;
+	while ( in >> cost.nTests >> cost.nTactics >> cost.nBranches >> cost.time )
+	{
+		in.get();	// separator
+		if ( !std::getline ( in, name ) )
+			break;
+		Known[name] = cost;
+	}
+	return true;
+}
+
+/// save known costs to the file FILENAME; @return false if the file can not be written
+bool
+TCostProfile :: save ( const std::string& filename ) const
+{
+	std::ofstream out(filename.c_str());
+	out << CostProfileHeader << "\n";
+	for ( CostMap::const_iterator p = Known.begin(), p_end = Known.end(); p != p_end; ++p )
+		out << p->second.nTests << " " << p->second.nTactics << " " << p->second.nBranches << " "
+			<< p->second.time << " " << p->first << "\n";
+	return out.good();
+}
+
+/// helper to compare concepts by the time of their tests: the expensive ones go first
+static bool
+moreExpensive ( const std::pair<float, std::string>& p, const std::pair<float, std::string>& q )
+{
+	return p.first > q.first || ( p.first == q.first && p.second < q.second );
+}
+
+/// print N most expensive concepts of the current run to O; mark the outliers
+void
+TCostProfile :: print ( std::ostream& o, unsigned int n ) const
+{
+	if ( Current.empty() )
+		return;
+
+	// an outlier takes more time than the mean plus 3 standard deviations
+	std::vector<std::pair<float, std::string> > Costs;
+	double sum = 0, sum2 = 0;
+	for ( CostMap::const_iterator p = Current.begin(), p_end = Current.end(); p != p_end; ++p )
+	{
+		Costs.push_back(std::make_pair(p->second.time,p->first));
+		sum += p->second.time;
+		sum2 += p->second.time * p->second.time;
+	}
+	double mean = sum / Costs.size();
+	double limit = mean + 3 * sqrt ( std::max ( 0.0, sum2 / Costs.size() - mean * mean ) );
+	std::sort ( Costs.begin(), Costs.end(), moreExpensive );
+
+	o << "Tests of " << Costs.size() << " concepts took " << sum << " sec; the most expensive ones are:\n";
+	for ( unsigned int i = 0; i < n && i < Costs.size(); ++i )
+	{
+		const TCostRecord& cost = Current.find(Costs[i].second)->second;
+		o << "  " << Costs[i].second << ": " << cost.nTests << " tests, " << cost.nTactics << " tactic calls, "
+		  << cost.nBranches << " branching points, " << cost.time << " sec";
+		if ( cost.time > limit )
+			o << " (outlier)";
+		o << "\n";
+	}
+}
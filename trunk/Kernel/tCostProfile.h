@@ -0,0 +1,135 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TCOSTPROFILE_H
+#define TCOSTPROFILE_H
+
+#include <map>
+#include <string>
+#include <iostream>
+
+#include "procTimer.h"
+
+/// cost of the reasoning tests of a single concept
+struct TCostRecord
+{
+		/// number of tests
+	unsigned long nTests;
+		/// number of tactic calls
+	unsigned long nTactics;
+		/// number of branching points
+	unsigned long nBranches;
+		/// wall-clock time of the tests in seconds
+	float time;
+
+		/// empty c'tor
+	TCostRecord ( void ) : nTests(0), nTactics(0), nBranches(0), time(0) {}
+
+		/// add cost C to the current one
+	void add ( const TCostRecord& c )
+	{
+		nTests += c.nTests;
+		nTactics += c.nTactics;
+		nBranches += c.nBranches;
+		time += c.time;
+	}
+}; // TCostRecord
+
+/// measure the cost of a single test using the counters of the reasoner
+class TCostMeter
+{
+protected:	// members
+		/// counters of the reasoner at the start of the test
+	TCostRecord Start;
+		/// timer of the test
+	TsWallTimer Timer;
+
+public:		// interface
+		/// empty c'tor
+	TCostMeter ( void ) {}
+		/// empty d'tor
+	~TCostMeter ( void ) {}
+
+		/// start the test given the values of the reasoner's counters
+	void start ( unsigned long nTactics, unsigned long nBranches )
+	{
+		Start.nTactics = nTactics;
+		Start.nBranches = nBranches;
+		Timer.Reset();
+		Timer.Start();
+	}
+		/// finish the test given the values of the reasoner's counters; @return the cost of the test
+	TCostRecord finish ( unsigned long nTactics, unsigned long nBranches )
+	{
+		Timer.Stop();
+		TCostRecord ret;
+		ret.nTests = 1;
+		ret.nTactics = nTactics - Start.nTactics;
+		ret.nBranches = nBranches - Start.nBranches;
+		ret.time = Timer;
+		return ret;
+	}
+}; // TCostMeter
+
+/**
+ *	Per-concept costs of the reasoning tests. The costs measured in the
+ *	current run are kept separately from the ones known from the previous
+ *	runs; the latter are used to order the classification. The profile is
+ *	saved in a text file, concepts are identified by their names.
+ */
+class TCostProfile
+{
+protected:	// types
+		/// map between concept names and their costs
+	typedef std::map<std::string, TCostRecord> CostMap;
+
+protected:	// members
+		/// costs known from the previous runs
+	CostMap Known;
+		/// costs measured in the current run
+	CostMap Current;
+
+public:		// interface
+		/// empty c'tor
+	TCostProfile ( void ) {}
+		/// empty d'tor
+	~TCostProfile ( void ) {}
+
+		/// add the COST of a test of the concept NAME to the current run
+	void add ( const std::string& name, const TCostRecord& cost ) { Current[name].add(cost); }
+		/// @return true iff there are no costs known from the previous runs
+	bool noKnownCosts ( void ) const { return Known.empty(); }
+		/// @return the number of tactic calls known for the concept NAME; 0 if unknown
+	unsigned long getKnownCost ( const std::string& name ) const
+	{
+		CostMap::const_iterator p = Known.find(name);
+		return p == Known.end() ? 0 : p->second.nTactics;
+	}
+		/// replace the known costs with the ones measured in the current run; start a new run
+	void update ( void );
+
+		/// load known costs from the file FILENAME; @return false if the file can not be read
+	bool load ( const std::string& filename );
+		/// save known costs to the file FILENAME; @return false if the file can not be written
+	bool save ( const std::string& filename ) const;
+
+		/// print N most expensive concepts of the current run to O; mark the outliers
+	void print ( std::ostream& o, unsigned int n = 10 ) const;
+}; // TCostProfile
+
+#endif
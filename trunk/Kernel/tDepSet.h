@@ -20,6 +20,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #define TDEPSET_H
 
 #include <map>
+#include <vector>
 #include <iostream>
 
 #include "fpp_assert.h"
@@ -65,6 +66,8 @@ public:		// interface
 	unsigned int level ( void ) const { return Level; }
 		/// get pointer to the Tail DSE
 	TDepSetElement* tail ( void ) const { return Tail; }
+		/// get the manager of the DSE
+	TDepSetManager* getManager ( void ) const { return Manager; }
 		/// merge this element with ELEM; use Manager for this
 	TDepSetElement* merge ( TDepSetElement* elem );
 		/// Print given dep-set to a standart stream
@@ -242,6 +245,15 @@ public:		// interface
 			clear();
 	}
 
+		/// add all the levels of the dep-set to LEVELS
+	void getLevels ( std::vector<unsigned int>& levels ) const
+	{
+		for ( TDepSetElement* p = dep; p; p = p->tail() )
+			levels.push_back(p->level());
+	}
+		/// Print levels of a (non-empty) dep-set to a standart stream
+	template <class O>
+	void printLevels ( O& o ) const { dep->Print(o); }
 		/// Print given dep-set to a standart stream
 	template <class O>
 	void Print ( O& o ) const
@@ -249,7 +261,7 @@ public:		// interface
 		if ( !empty() )
 		{
 			o << "{";
-			dep->Print(o);
+			printLevels(o);
 			o << "}";
 		}
 	}
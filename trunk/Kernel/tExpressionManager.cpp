@@ -55,6 +55,7 @@ TExpressionManager :: clear ( void )
 	NS_DR.clear();
 	InverseRoleCache.clear();
 	OneOfCache.clear();
+	ExpressionCache.clear();
 	// delete all the recorded references
 	for ( std::vector<TDLExpression*>::iterator p = RefRecorder.begin(), p_end = RefRecorder.end(); p < p_end; ++p )
 		delete *p;
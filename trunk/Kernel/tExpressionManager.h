@@ -19,6 +19,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef TEXPRESSIONMANAGER_H
 #define TEXPRESSIONMANAGER_H
 
+#include <map>
+#include <typeinfo>
+
 #include "tDLExpression.h"
 #include "tNameSet.h"
 #include "tNAryQueue.h"
@@ -69,6 +72,34 @@ protected:	// types
 			/// clear the cache
 		void clear ( void ) { Map.clear(); }
 	}; // TInverseRoleCache
+		/// structural key of a complex expression: its class, numeric parameter and arguments
+	class TExpressionKey
+	{
+	public:		// members
+			/// class of the expression
+		const std::type_info* Kind;
+			/// numeric parameter (if any)
+		unsigned int N;
+			/// arguments of the expression
+		std::vector<const TDLExpression*> Args;
+
+	public:		// interface
+			/// init c'tor
+		TExpressionKey ( const std::type_info& kind, unsigned int n = 0 ) : Kind(&kind), N(n) {}
+			/// add an argument ARG; @return the key
+		TExpressionKey& add ( const TDLExpression* arg ) { Args.push_back(arg); return *this; }
+			/// compare keys; arguments are compared as pointers as they are unique themselves
+		bool operator < ( const TExpressionKey& key ) const
+		{
+			if ( *Kind != *key.Kind )
+				return Kind->before(*key.Kind);
+			if ( N != key.N )
+				return N < key.N;
+			return Args < key.Args;
+		}
+	}; // TExpressionKey
+		/// cache for all the complex expressions
+	typedef std::map<TExpressionKey, TDLExpression*> TExpressionCache;
 
 protected:	// members
 		/// nameset for concepts
@@ -109,11 +140,63 @@ protected:	// members
 	TInverseRoleCache InverseRoleCache;
 		/// cache for the one-of singletons
 	TOneOfCache OneOfCache;
+		/// cache for all other complex expressions
+	TExpressionCache ExpressionCache;
 
 protected:	// methods
 		/// record the reference; @return the argument
 	template<class T>
 	T* record ( T* arg ) { RefRecorder.push_back(arg); return arg; }
+		/// @return an expression of a class T with a given KEY if it was created before; NULL otherwise
+	template<class T>
+	T* getCached ( const TExpressionKey& key ) const
+	{
+		TExpressionCache::const_iterator p = ExpressionCache.find(key);
+		return p == ExpressionCache.end() ? NULL : static_cast<T*>(p->second);
+	}
+		/// record EXPR and cache it with a given KEY; @return EXPR
+	template<class T>
+	T* setCached ( const TExpressionKey& key, T* expr )
+	{
+		ExpressionCache[key] = expr;
+		return record(expr);
+	}
+		/// @return the only expression T(A)
+	template<class T, class A>
+	T* unique ( const A* a )
+	{
+		TExpressionKey key(typeid(T));
+		key.add(a);
+		T* ret = getCached<T>(key);
+		return ret ? ret : setCached ( key, new T(a) );
+	}
+		/// @return the only expression T(A,B)
+	template<class T, class A, class B>
+	T* unique ( const A* a, const B* b )
+	{
+		TExpressionKey key(typeid(T));
+		key.add(a).add(b);
+		T* ret = getCached<T>(key);
+		return ret ? ret : setCached ( key, new T(a,b) );
+	}
+		/// @return the only expression T(N,A,B)
+	template<class T, class A, class B>
+	T* unique ( unsigned int n, const A* a, const B* b )
+	{
+		TExpressionKey key(typeid(T),n);
+		key.add(a).add(b);
+		T* ret = getCached<T>(key);
+		return ret ? ret : setCached ( key, new T(n,a,b) );
+	}
+		/// @return the only n-ary expression T with the arguments ARGS
+	template<class T>
+	T* uniqueNAry ( const std::vector<const TDLExpression*>& args )
+	{
+		TExpressionKey key(typeid(T));
+		key.Args = args;
+		T* ret = getCached<T>(key);
+		return ret ? ret : setCached ( key, new T(key.Args) );
+	}
 		/// clear the TNamedEntry cache for all elements of a name-set NS
 	template<class T>
 	void clearNameCache ( TNameSet<T>& ns )
@@ -187,14 +270,14 @@ public:		// interface
 		/// get named concept
 	TDLConceptName* Concept ( const std::string& name ) { return NS_C.insert(name); }
 		/// get negation of a concept C
-	TDLConceptExpression* Not ( const TDLConceptExpression* C ) { return record(new TDLConceptNot(C)); }
+	TDLConceptExpression* Not ( const TDLConceptExpression* C ) { return unique<TDLConceptNot>(C); }
 		/// get an n-ary conjunction expression; take the arguments from the last argument list
-	TDLConceptExpression* And ( void ) { return record(new TDLConceptAnd(getArgList())); }
+	TDLConceptExpression* And ( void ) { return uniqueNAry<TDLConceptAnd>(getArgList()); }
 		/// @return C and D
 	TDLConceptExpression* And ( const TDLConceptExpression* C, const TDLConceptExpression* D )
 		{ newArgList(); addArg(C); addArg(D); return And(); }
 		/// get an n-ary disjunction expression; take the arguments from the last argument list
-	TDLConceptExpression* Or ( void ) { return record(new TDLConceptOr(getArgList())); }
+	TDLConceptExpression* Or ( void ) { return uniqueNAry<TDLConceptOr>(getArgList()); }
 		/// @return C or D
 	TDLConceptExpression* Or ( const TDLConceptExpression* C, const TDLConceptExpression* D )
 		{ newArgList(); addArg(C); addArg(D); return Or(); }
@@ -204,50 +287,50 @@ public:		// interface
 		const std::vector<const TDLExpression*>& v = getArgList();
 		if ( v.size() == 1 )
 			return OneOfCache.get(static_cast<const TDLIndividualExpression*>(v.front()));
-		return record(new TDLConceptOneOf(v));
+		return uniqueNAry<TDLConceptOneOf>(v);
 	}
 		/// @return concept {I} for the individual I
 	TDLConceptExpression* OneOf ( const TDLIndividualExpression* I ) { return OneOfCache.get(I); }
 
 		/// get self-reference restriction of an object role R
-	TDLConceptExpression* SelfReference ( const TDLObjectRoleExpression* R ) { return record(new TDLConceptObjectSelf(R)); }
+	TDLConceptExpression* SelfReference ( const TDLObjectRoleExpression* R ) { return unique<TDLConceptObjectSelf>(R); }
 		/// get value restriction wrt an object role R and an individual I
 	TDLConceptExpression* Value ( const TDLObjectRoleExpression* R, const TDLIndividualExpression* I )
-		{ return record(new TDLConceptObjectValue(R,I)); }
+		{ return unique<TDLConceptObjectValue>(R,I); }
 		/// get existential restriction wrt an object role R and a concept C
 	TDLConceptExpression* Exists ( const TDLObjectRoleExpression* R, const TDLConceptExpression* C )
-		{ return record(new TDLConceptObjectExists(R,C)); }
+		{ return unique<TDLConceptObjectExists>(R,C); }
 		/// get universal restriction wrt an object role R and a concept C
 	TDLConceptExpression* Forall ( const TDLObjectRoleExpression* R, const TDLConceptExpression* C )
-		{ return record(new TDLConceptObjectForall(R,C)); }
+		{ return unique<TDLConceptObjectForall>(R,C); }
 		/// get min cardinality restriction wrt number N, an object role R and a concept C
 	TDLConceptExpression* MinCardinality ( unsigned int n, const TDLObjectRoleExpression* R, const TDLConceptExpression* C )
-		{ return record(new TDLConceptObjectMinCardinality(n,R,C)); }
+		{ return unique<TDLConceptObjectMinCardinality>(n,R,C); }
 		/// get max cardinality restriction wrt number N, an object role R and a concept C
 	TDLConceptExpression* MaxCardinality ( unsigned int n, const TDLObjectRoleExpression* R, const TDLConceptExpression* C )
-		{ return record(new TDLConceptObjectMaxCardinality(n,R,C)); }
+		{ return unique<TDLConceptObjectMaxCardinality>(n,R,C); }
 		/// get exact cardinality restriction wrt number N, an object role R and a concept C
 	TDLConceptExpression* Cardinality ( unsigned int n, const TDLObjectRoleExpression* R, const TDLConceptExpression* C )
-		{ return record(new TDLConceptObjectExactCardinality(n,R,C)); }
+		{ return unique<TDLConceptObjectExactCardinality>(n,R,C); }
 
 		/// get value restriction wrt a data role R and a data value V
 	TDLConceptExpression* Value ( const TDLDataRoleExpression* R, const TDLDataValue* V )
-		{ return record(new TDLConceptDataValue(R,V)); }
+		{ return unique<TDLConceptDataValue>(R,V); }
 		/// get existential restriction wrt a data role R and a data expression E
 	TDLConceptExpression* Exists ( const TDLDataRoleExpression* R, const TDLDataExpression* E )
-		{ return record(new TDLConceptDataExists(R,E)); }
+		{ return unique<TDLConceptDataExists>(R,E); }
 		/// get universal restriction wrt a data role R and a data expression E
 	TDLConceptExpression* Forall ( const TDLDataRoleExpression* R, const TDLDataExpression* E )
-		{ return record(new TDLConceptDataForall(R,E)); }
+		{ return unique<TDLConceptDataForall>(R,E); }
 		/// get min cardinality restriction wrt number N, a data role R and a data expression E
 	TDLConceptExpression* MinCardinality ( unsigned int n, const TDLDataRoleExpression* R, const TDLDataExpression* E )
-		{ return record(new TDLConceptDataMinCardinality(n,R,E)); }
+		{ return unique<TDLConceptDataMinCardinality>(n,R,E); }
 		/// get max cardinality restriction wrt number N, a data role R and a data expression E
 	TDLConceptExpression* MaxCardinality ( unsigned int n, const TDLDataRoleExpression* R, const TDLDataExpression* E )
-		{ return record(new TDLConceptDataMaxCardinality(n,R,E)); }
+		{ return unique<TDLConceptDataMaxCardinality>(n,R,E); }
 		/// get exact cardinality restriction wrt number N, a data role R and a data expression E
 	TDLConceptExpression* Cardinality ( unsigned int n, const TDLDataRoleExpression* R, const TDLDataExpression* E )
-		{ return record(new TDLConceptDataExactCardinality(n,R,E)); }
+		{ return unique<TDLConceptDataExactCardinality>(n,R,E); }
 
 	// individuals
 
@@ -265,13 +348,13 @@ public:		// interface
 		/// get an inverse of a given object role expression R
 	TDLObjectRoleExpression* Inverse ( const TDLObjectRoleExpression* R ) { return InverseRoleCache.get(R); }
 		/// get a role chain corresponding to R1 o ... o Rn; take the arguments from the last argument list
-	TDLObjectRoleComplexExpression* Compose ( void ) { return record(new TDLObjectRoleChain(getArgList())); }
+	TDLObjectRoleComplexExpression* Compose ( void ) { return uniqueNAry<TDLObjectRoleChain>(getArgList()); }
 		/// get a expression corresponding to R projected from C
 	TDLObjectRoleComplexExpression* ProjectFrom ( const TDLObjectRoleExpression* R, const TDLConceptExpression* C )
-		{ return record(new TDLObjectRoleProjectionFrom(R,C)); }
+		{ return unique<TDLObjectRoleProjectionFrom>(R,C); }
 		/// get a expression corresponding to R projected into C
 	TDLObjectRoleComplexExpression* ProjectInto ( const TDLObjectRoleExpression* R, const TDLConceptExpression* C )
-		{ return record(new TDLObjectRoleProjectionInto(R,C)); }
+		{ return unique<TDLObjectRoleProjectionInto>(R,C); }
 
 	// data roles
 
@@ -321,22 +404,22 @@ public:		// interface
 		// That is, value of a type positiveInteger will be of a type Integer
 	const TDLDataValue* DataValue ( const std::string& value, TDLDataTypeExpression* type ) { return getBasicDataType(type)->getValue(value); }
 		/// get negation of a data expression E
-	TDLDataExpression* DataNot ( const TDLDataExpression* E ) { return record(new TDLDataNot(E)); }
+	TDLDataExpression* DataNot ( const TDLDataExpression* E ) { return unique<TDLDataNot>(E); }
 		/// get an n-ary data conjunction expression; take the arguments from the last argument list
-	TDLDataExpression* DataAnd ( void ) { return record(new TDLDataAnd(getArgList())); }
+	TDLDataExpression* DataAnd ( void ) { return uniqueNAry<TDLDataAnd>(getArgList()); }
 		/// get an n-ary data disjunction expression; take the arguments from the last argument list
-	TDLDataExpression* DataOr ( void ) { return record(new TDLDataOr(getArgList())); }
+	TDLDataExpression* DataOr ( void ) { return uniqueNAry<TDLDataOr>(getArgList()); }
 		/// get an n-ary data one-of expression; take the arguments from the last argument list
-	TDLDataExpression* DataOneOf ( void ) { return record(new TDLDataOneOf(getArgList())); }
+	TDLDataExpression* DataOneOf ( void ) { return uniqueNAry<TDLDataOneOf>(getArgList()); }
 
 		/// get minInclusive facet with a given VALUE
-	const TDLFacetExpression* FacetMinInclusive ( const TDLDataValue* V ) { return record(new TDLFacetMinInclusive(V)); }
+	const TDLFacetExpression* FacetMinInclusive ( const TDLDataValue* V ) { return unique<TDLFacetMinInclusive>(V); }
 		/// get minExclusive facet with a given VALUE
-	const TDLFacetExpression* FacetMinExclusive ( const TDLDataValue* V ) { return record(new TDLFacetMinExclusive(V)); }
+	const TDLFacetExpression* FacetMinExclusive ( const TDLDataValue* V ) { return unique<TDLFacetMinExclusive>(V); }
 		/// get maxInclusive facet with a given VALUE
-	const TDLFacetExpression* FacetMaxInclusive ( const TDLDataValue* V ) { return record(new TDLFacetMaxInclusive(V)); }
+	const TDLFacetExpression* FacetMaxInclusive ( const TDLDataValue* V ) { return unique<TDLFacetMaxInclusive>(V); }
 		/// get maxExclusive facet with a given VALUE
-	const TDLFacetExpression* FacetMaxExclusive ( const TDLDataValue* V ) { return record(new TDLFacetMaxExclusive(V)); }
+	const TDLFacetExpression* FacetMaxExclusive ( const TDLDataValue* V ) { return unique<TDLFacetMaxExclusive>(V); }
 
 }; // TExpressionManager
 
@@ -0,0 +1,73 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TMUTEX_H
+#define TMUTEX_H
+
+#include <pthread.h>
+
+/// simple wrapper around the pthread mutex
+class TMutex
+{
+protected:	// members
+		/// mutex itself
+	pthread_mutex_t Mutex;
+
+private:	// no copy
+		/// no copy c'tor
+	TMutex ( const TMutex& );
+		/// no assignment
+	TMutex& operator = ( const TMutex& );
+
+public:		// interface
+		/// init c'tor
+	TMutex ( void ) { pthread_mutex_init ( &Mutex, NULL ); }
+		/// d'tor
+	~TMutex ( void ) { pthread_mutex_destroy(&Mutex); }
+
+		/// lock the mutex
+	void lock ( void ) { pthread_mutex_lock(&Mutex); }
+		/// unlock the mutex
+	void unlock ( void ) { pthread_mutex_unlock(&Mutex); }
+		/// get access to the underlying mutex (for the conditions)
+	pthread_mutex_t* get ( void ) { return &Mutex; }
+}; // TMutex
+
+/// lock the mutex for the lifetime of the object
+class TMutexLock
+{
+protected:	// members
+		/// locked mutex
+	TMutex& Mutex;
+		/// true iff the mutex is locked by this object
+	bool Locked;
+
+private:	// no copy
+		/// no copy c'tor
+	TMutexLock ( const TMutexLock& );
+		/// no assignment
+	TMutexLock& operator = ( const TMutexLock& );
+
+public:		// interface
+		/// c'tor: lock given mutex if NEEDLOCK is true
+	TMutexLock ( TMutex& m, bool needLock = true ) : Mutex(m), Locked(needLock) { if ( Locked ) Mutex.lock(); }
+		/// d'tor: unlock the mutex
+	~TMutexLock ( void ) { if ( Locked ) Mutex.unlock(); }
+}; // TMutexLock
+
+#endif
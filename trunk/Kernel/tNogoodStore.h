@@ -0,0 +1,263 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TNOGOODSTORE_H
+#define TNOGOODSTORE_H
+
+#include <vector>
+#include <algorithm>
+
+#include "BiPointer.h"
+#include "DepSet.h"
+
+/**
+ *	Store of the nogoods learned from the clash sets of a single satisfiability
+ *	test. Every branching level remembers the concepts the branching operation
+ *	added to the completion graph. If a clash depends only on a few levels, the
+ *	concepts of these levels are recorded as a nogood: together with the input
+ *	they are unsatisfiable. A nogood refers to the nodes by their IDs, so it is
+ *	removed as soon as one of its nodes is removed from the completion graph.
+ */
+class TNogoodStore
+{
+public:		// types
+		/// concept C in the label of the node with ID Node
+	struct Fact
+	{
+			/// ID of the node
+		unsigned int Node;
+			/// concept in the label
+		BipolarPointer C;
+			/// init c'tor
+		Fact ( unsigned int node, BipolarPointer c ) : Node(node), C(c) {}
+			/// check the equality of two facts
+		bool operator == ( const Fact& f ) const { return Node == f.Node && C == f.C; }
+			/// order facts by their nodes
+		bool operator < ( const Fact& f ) const { return Node < f.Node || ( Node == f.Node && C < f.C ); }
+	}; // Fact
+		/// set of facts
+	typedef std::vector<Fact> FactVector;
+		/// RO iterator over facts
+	typedef FactVector::const_iterator const_iterator;
+		/// concept of a fact together with the ID of the nogood it belongs to
+	typedef std::pair<BipolarPointer,unsigned int> Entry;
+		/// entries of the nogoods about a single node, sorted
+	typedef std::vector<Entry> EntryVector;
+		/// RO iterator over entries
+	typedef EntryVector::const_iterator entry_iterator;
+		/// range of entries
+	typedef std::pair<entry_iterator,entry_iterator> EntryRange;
+
+protected:	// types
+		/// compare entries by their concepts only
+	struct ConceptLess
+	{
+		bool operator() ( const Entry& e1, const Entry& e2 ) const { return e1.first < e2.first; }
+	}; // ConceptLess
+
+protected:	// members
+		/// facts introduced by the branching operation of every level; empty for unsupported operations
+	std::vector<FactVector> Decisions;
+		/// all the nogoods; empty vector is a free slot
+	std::vector<FactVector> Nogoods;
+		/// free slots in Nogoods
+	std::vector<unsigned int> FreeSlots;
+		/// facts of all the nogoods indexed by their nodes
+	std::vector<EntryVector> ByNode;
+		/// all the nodes with IDs NINDEXED and above have no nogoods
+	unsigned int nIndexed;
+		/// temporary vector for the levels of a clash-set
+	std::vector<unsigned int> Levels;
+		/// maximal number of the kept nogoods; 0 switches the store off
+	unsigned int Capacity;
+		/// number of the kept nogoods
+	unsigned int nNogoods;
+		/// number of the nogoods learned since the last clear
+	unsigned int nLearned;
+
+protected:	// methods
+		/// maximal number of the branching levels in the nogood
+	static unsigned int maxNogoodLevels ( void ) { return 4; }
+		/// maximal number of the facts in the nogood
+	static unsigned int maxNogoodSize ( void ) { return 8; }
+		/// remove the nogood ID from the index of the nodes below LIMIT
+	void remove ( unsigned int id, unsigned int limit )
+	{
+		FactVector& nogood = Nogoods[id];
+		for ( const_iterator p = nogood.begin(), p_end = nogood.end(); p != p_end; ++p )
+			if ( p->Node < limit )
+			{
+				EntryVector& entries = ByNode[p->Node];
+				EntryVector::iterator q = std::lower_bound ( entries.begin(), entries.end(), Entry(p->C,id) );
+				if ( q != entries.end() && *q == Entry(p->C,id) )
+					entries.erase(q);
+			}
+		nogood.clear();
+		FreeSlots.push_back(id);
+		--nNogoods;
+	}
+		/// @return the slot for a new nogood
+	unsigned int newSlot ( void )
+	{
+		if ( nNogoods >= Capacity )	// the store is full: start from scratch
+			clearNogoods();
+		++nNogoods;
+		if ( FreeSlots.empty() )
+		{
+			Nogoods.push_back(FactVector());
+			return Nogoods.size()-1;
+		}
+		unsigned int id = FreeSlots.back();
+		FreeSlots.pop_back();
+		return id;
+	}
+		/// remove all the nogoods; keep the memory for the new ones
+	void clearNogoods ( void )
+	{
+		if ( nNogoods == 0 )	// all the slots are free already
+			return;
+		FreeSlots.clear();
+		for ( unsigned int id = Nogoods.size(); id > 0; --id )
+		{
+			Nogoods[id-1].clear();
+			FreeSlots.push_back(id-1);
+		}
+		for ( unsigned int node = 0; node < nIndexed; ++node )
+			ByNode[node].clear();
+		nIndexed = 0;
+		nNogoods = 0;
+	}
+
+private:	// no copy
+		/// no copy c'tor
+	TNogoodStore ( const TNogoodStore& );
+		/// no assignment
+	TNogoodStore& operator = ( const TNogoodStore& );
+
+public:		// interface
+		/// empty c'tor
+	TNogoodStore ( void ) : nIndexed(0), Capacity(0), nNogoods(0), nLearned(0) {}
+		/// empty d'tor
+	~TNogoodStore ( void ) {}
+
+		/// set the maximal number of the kept nogoods; 0 switches the store off
+	void setCapacity ( unsigned int capacity ) { Capacity = capacity; clear(); }
+		/// @return true iff the store is in use
+	bool isActive ( void ) const { return Capacity > 0; }
+		/// forget all the nogoods and decisions
+	void clear ( void )
+	{
+		clearNogoods();
+		for ( std::vector<FactVector>::iterator p = Decisions.begin(), p_end = Decisions.end(); p != p_end; ++p )
+			p->clear();
+		nLearned = 0;
+	}
+
+	// branching decisions
+
+		/// start a new branching operation on LEVEL
+	void startDecision ( unsigned int level )
+	{
+		if ( level >= Decisions.size() )
+			Decisions.resize(level+1);
+		Decisions[level].clear();
+	}
+		/// register that the branching operation on LEVEL adds C to the node with ID NODE
+	void addDecisionFact ( unsigned int level, unsigned int node, BipolarPointer C )
+		{ Decisions[level].push_back(Fact(node,C)); }
+
+	// learning
+
+		/// record the facts of the levels of the CLASH-set as a nogood if they are known and there are few of them
+	void learn ( const DepSet& clash )
+	{
+		Levels.clear();
+		clash.getLevels(Levels);
+		if ( Levels.empty() || Levels.size() > maxNogoodLevels() )
+			return;
+
+		unsigned int size = 0;
+		for ( std::vector<unsigned int>::const_iterator p = Levels.begin(), p_end = Levels.end(); p != p_end; ++p )
+		{	// all the levels should come from the supported operations
+			if ( *p >= Decisions.size() || Decisions[*p].empty() )
+				return;
+			size += Decisions[*p].size();
+		}
+		if ( size > maxNogoodSize() )
+			return;
+
+		unsigned int id = newSlot();
+		FactVector& nogood = Nogoods[id];
+		for ( std::vector<unsigned int>::const_iterator p = Levels.begin(), p_end = Levels.end(); p != p_end; ++p )
+			nogood.insert ( nogood.end(), Decisions[*p].begin(), Decisions[*p].end() );
+		// every fact should appear only once
+		std::sort ( nogood.begin(), nogood.end() );
+		nogood.erase ( std::unique ( nogood.begin(), nogood.end() ), nogood.end() );
+		for ( const_iterator p = nogood.begin(), p_end = nogood.end(); p != p_end; ++p )
+		{
+			if ( p->Node >= ByNode.size() )
+				ByNode.resize(p->Node+1);
+			if ( p->Node >= nIndexed )
+				nIndexed = p->Node+1;
+			EntryVector& entries = ByNode[p->Node];
+			entries.insert ( std::upper_bound ( entries.begin(), entries.end(), Entry(p->C,id) ), Entry(p->C,id) );
+		}
+		++nLearned;
+	}
+		/// remove the nogoods about the nodes with IDs NNODES and above
+	void restore ( unsigned int nNodes )
+	{
+		for ( unsigned int node = nNodes; node < nIndexed; ++node )
+		{
+			EntryVector& entries = ByNode[node];
+			for ( entry_iterator p = entries.begin(), p_end = entries.end(); p != p_end; ++p )
+				if ( !Nogoods[p->second].empty() )	// not removed through another node
+					remove ( p->second, nNodes );
+			entries.clear();
+		}
+		if ( nIndexed > nNodes )
+			nIndexed = nNodes;
+	}
+
+	// access to the nogoods
+
+		/// @return entries of the nogoods that contain C in the label of the node with ID NODE
+	EntryRange getNogoods ( unsigned int node, BipolarPointer C ) const
+	{
+		if ( node >= nIndexed )
+			return EntryRange();
+		const EntryVector& entries = ByNode[node];
+		return std::equal_range ( entries.begin(), entries.end(), Entry(C,0), ConceptLess() );
+	}
+		/// begin of the nogood ID
+	const_iterator begin ( unsigned int id ) const { return Nogoods[id].begin(); }
+		/// end of the nogood ID
+	const_iterator end ( unsigned int id ) const { return Nogoods[id].end(); }
+		/// make the fact P of the nogood ID the first one to check: a fact that is not in the graph now is likely to be absent later
+	void setFirstFact ( unsigned int id, const_iterator p )
+	{
+		FactVector& nogood = Nogoods[id];
+		std::iter_swap ( nogood.begin(), nogood.begin() + (p - nogood.begin()) );
+	}
+		/// @return number of the kept nogoods
+	unsigned int size ( void ) const { return nNogoods; }
+		/// @return number of the nogoods learned since the last clear
+	unsigned int getNLearned ( void ) const { return nLearned; }
+}; // TNogoodStore
+
+#endif
@@ -0,0 +1,151 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TQUERYCACHE_H
+#define TQUERYCACHE_H
+
+#include <list>
+#include <map>
+
+#include "taxVertex.h"
+#include "dlTBox.h"	// KBStatus
+
+class TDLConceptExpression;
+
+/**
+ *	Bounded LRU cache of the results of queries about complex concept
+ *	expressions. As the expressions are hash-consed by the expression
+ *	manager, the address of an expression is its structural key. Every
+ *	entry keeps the satisfiability of the query and the position of the
+ *	query in the taxonomy. The cache is valid for a single KB status only.
+ */
+class TQueryCache
+{
+public:		// types
+		/// results of a single query
+	struct Entry
+	{
+			/// satisfiability of the query: 1 if satisfiable, 0 if not, -1 if unknown
+		int Sat;
+			/// position of the query in the taxonomy; NULL if unknown
+		TaxonomyVertex* Vertex;
+			/// copy of the query vertex if it is not a part of the taxonomy
+		TaxonomyVertex Copy;
+
+			/// empty c'tor
+		Entry ( void ) : Sat(-1), Vertex(NULL) {}
+			/// set the taxonomy position to V; copy V iff it is a TEMPORARY vertex that is re-used by the next query
+		void setVertex ( TaxonomyVertex* v, bool temporary )
+		{
+			if ( temporary )
+			{
+				Copy = *v;
+				Vertex = &Copy;
+			}
+			else
+				Vertex = v;
+		}
+	}; // Entry
+
+protected:	// types
+		/// query together with its results
+	typedef std::pair<const TDLConceptExpression*, Entry> QueryEntry;
+		/// queries ordered from the most recently used to the least recently used one
+	typedef std::list<QueryEntry> QueryList;
+		/// index of the queries
+	typedef std::map<const TDLConceptExpression*, QueryList::iterator> QueryMap;
+
+protected:	// members
+		/// all the cached queries in the LRU order
+	QueryList Queries;
+		/// map from the query to its place in the list
+	QueryMap Index;
+		/// maximal number of the cached queries
+	unsigned int Capacity;
+		/// status of the KB for which the results are valid
+	KBStatus Status;
+		/// number of queries answered from the cache
+	unsigned long nHits;
+		/// number of queries that were not answered from the cache
+	unsigned long nMisses;
+
+private:	// no copy
+		/// no copy c'tor
+	TQueryCache ( const TQueryCache& );
+		/// no assignment
+	TQueryCache& operator = ( const TQueryCache& );
+
+public:		// interface
+		/// empty c'tor
+	TQueryCache ( void ) : Capacity(0), Status(kbEmpty), nHits(0), nMisses(0) {}
+		/// empty d'tor
+	~TQueryCache ( void ) {}
+
+		/// set the maximal number of the cached queries; 0 switches the cache off
+	void setCapacity ( unsigned int capacity ) { Capacity = capacity; clear(); }
+		/// @return true iff the cache is in use
+	bool isActive ( void ) const { return Capacity > 0; }
+		/// forget all the cached queries
+	void clear ( void )
+	{
+		Queries.clear();
+		Index.clear();
+	}
+		/// make sure the cache contains results for the KB status STATUS only
+	void checkStatus ( KBStatus status )
+	{
+		if ( status != Status )
+		{
+			clear();
+			Status = status;
+		}
+	}
+
+		/// @return entry for the query C; create an empty one if necessary
+	Entry& get ( const TDLConceptExpression* C )
+	{
+		QueryMap::iterator p = Index.find(C);
+		if ( p != Index.end() )
+		{	// move the entry to the front
+			Queries.splice ( Queries.begin(), Queries, p->second );
+			return p->second->second;
+		}
+		Queries.push_front(QueryEntry(C,Entry()));
+		Index[C] = Queries.begin();
+		// remove the least recently used entry
+		if ( Queries.size() > Capacity )
+		{
+			Index.erase(Queries.back().first);
+			Queries.pop_back();
+		}
+		return Queries.front().second;
+	}
+		/// @return the number of the cached queries
+	size_t size ( void ) const { return Index.size(); }
+
+		/// register the query answered from the cache
+	void hit ( void ) { ++nHits; }
+		/// register the query that was not answered from the cache
+	void miss ( void ) { ++nMisses; }
+		/// get number of queries answered from the cache
+	unsigned long getNHits ( void ) const { return nHits; }
+		/// get number of queries that were not answered from the cache
+	unsigned long getNMisses ( void ) const { return nMisses; }
+}; // TQueryCache
+
+#endif
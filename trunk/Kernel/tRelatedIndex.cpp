@@ -0,0 +1,164 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <algorithm>
+
+#include "tRelatedIndex.h"
+#include "tRelated.h"
+#include "RoleMaster.h"
+
+/// compare roles by the number of the super-roles; sub-roles go first
+class TRoleAncCompare
+{
+public:
+	bool operator() ( const TRole* R, const TRole* S ) const
+		{ return (R->end_anc() - R->begin_anc()) > (S->end_anc() - S->begin_anc()); }
+}; // TRoleAncCompare
+
+void
+TRelatedIndex :: addEdges ( EdgeVec& out, const TRole* R, const TIndividual* J )
+{
+	out.push_back(Edge(R->getIndex(),J));
+	for ( TRole::const_iterator p = R->begin_anc(), p_end = R->end_anc(); p != p_end; ++p )
+		if ( !(*p)->isTop() )	// fillers of the universal role are processed separately
+			out.push_back(Edge((*p)->getIndex(),J));
+}
+
+void
+TRelatedIndex :: sortRow ( EdgeVec& out )
+{
+	std::sort ( out.begin(), out.end() );
+	out.erase ( std::unique ( out.begin(), out.end() ), out.end() );
+}
+
+void
+TRelatedIndex :: closeTransitive ( std::vector<EdgeVec>& rows, const TRole* R )
+{
+	unsigned int r = R->getIndex(), n = rows.size();
+	// new edges: <source index, filler>
+	std::vector<std::pair<unsigned int, const TIndividual*> > NewEdges;
+	std::vector<bool> Reached(n,false);
+	std::vector<const TIndividual*> ToDo, Visited;
+
+	for ( unsigned int a = 0; a < n; ++a )
+	{
+		EdgeRange direct = getRange ( rows[a], r );
+		if ( direct.first == direct.second )
+			continue;
+
+		// BFS over R-edges starting from the direct fillers
+		for ( const_iterator p = direct.first; p != direct.second; ++p )
+			if ( !Reached[p->J->index()] )
+			{
+				Reached[p->J->index()] = true;
+				ToDo.push_back(p->J);
+				Visited.push_back(p->J);
+			}
+		while ( !ToDo.empty() )
+		{
+			const TIndividual* cur = ToDo.back();
+			ToDo.pop_back();
+			EdgeRange next = getRange ( rows[cur->index()], r );
+			for ( const_iterator p = next.first; p != next.second; ++p )
+				if ( !Reached[p->J->index()] )
+				{
+					Reached[p->J->index()] = true;
+					ToDo.push_back(p->J);
+					Visited.push_back(p->J);
+					NewEdges.push_back(std::make_pair(a,p->J));
+				}
+		}
+
+		// clear the marks
+		for ( std::vector<const TIndividual*>::iterator p = Visited.begin(), p_end = Visited.end(); p != p_end; ++p )
+			Reached[(*p)->index()] = false;
+		Visited.clear();
+	}
+
+	if ( NewEdges.empty() )
+		return;
+
+	// add new edges for R and all its super-roles
+	std::vector<bool> Changed(n,false);
+	for ( std::vector<std::pair<unsigned int, const TIndividual*> >::iterator p = NewEdges.begin(), p_end = NewEdges.end(); p != p_end; ++p )
+	{
+		addEdges ( rows[p->first], R, p->second );
+		Changed[p->first] = true;
+	}
+	for ( unsigned int a = 0; a < n; ++a )
+		if ( Changed[a] )
+			sortRow(rows[a]);
+}
+
+void
+TRelatedIndex :: build ( const RelatedVec& Related, const RoleMaster& ORM, unsigned int nC )
+{
+	std::vector<EdgeVec> rows(nC);
+
+	// explicit assertions closed under role hierarchy; inverses are already in RELATED
+	for ( RelatedVec::const_iterator p = Related.begin(), p_end = Related.end(); p != p_end; ++p )
+	{
+		const TIndividual* a = resolveSynonym((*p)->a);
+		const TIndividual* b = resolveSynonym((*p)->b);
+		fpp_assert ( a->index() < nC && b->index() < nC );
+		addEdges ( rows[a->index()], resolveSynonym((*p)->R), b );
+	}
+	for ( std::vector<EdgeVec>::iterator p = rows.begin(), p_end = rows.end(); p != p_end; ++p )
+		sortRow(*p);
+
+	// close under transitivity; process sub-roles first, as they add edges to their super-roles
+	std::vector<const TRole*> Trans;
+	for ( RoleMaster::const_iterator p = ORM.begin(), p_end = ORM.end(); p != p_end; ++p )
+		if ( !(*p)->isSynonym() && !(*p)->isTop() && (*p)->isTransitive() )
+			Trans.push_back(*p);
+	std::stable_sort ( Trans.begin(), Trans.end(), TRoleAncCompare() );
+	for ( std::vector<const TRole*>::iterator p = Trans.begin(), p_end = Trans.end(); p != p_end; ++p )
+		closeTransitive ( rows, *p );
+
+	// build the compressed rows
+	Start.clear();
+	Edges.clear();
+	Start.reserve(nC+1);
+	for ( std::vector<EdgeVec>::iterator p = rows.begin(), p_end = rows.end(); p != p_end; ++p )
+	{
+		Start.push_back(Edges.size());
+		Edges.insert ( Edges.end(), p->begin(), p->end() );
+		EdgeVec().swap(*p);	// free memory as soon as possible
+	}
+	Start.push_back(Edges.size());
+}
+
+TRelatedIndex::EdgeRange
+TRelatedIndex :: getRange ( const TIndividual* I, const TRole* R ) const
+{
+	I = resolveSynonym(I);
+	unsigned int i = I->index();
+	// individuals that are not in the index have no edges; data roles are not indexed
+	if ( i+1 >= Start.size() || R->isDataRole() )
+		return EdgeRange ( Edges.end(), Edges.end() );
+	return std::equal_range ( Edges.begin()+Start[i], Edges.begin()+Start[i+1],
+							  resolveSynonym(R)->getIndex(), RoleLess() );
+}
+
+bool
+TRelatedIndex :: isRelated ( const TIndividual* I, const TRole* R, const TIndividual* J ) const
+{
+	J = resolveSynonym(J);
+	EdgeRange range = getRange ( I, R );
+	return std::binary_search ( range.first, range.second, Edge(resolveSynonym(R)->getIndex(),J) );
+}
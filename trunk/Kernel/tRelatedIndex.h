@@ -0,0 +1,135 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TRELATEDINDEX_H
+#define TRELATEDINDEX_H
+
+#include <vector>
+#include <algorithm>
+
+#include "tIndividual.h"
+#include "tRole.h"
+
+class TRelated;
+class RoleMaster;
+
+/**
+ *	Index of the role assertions R(a,b) of an ABox. The index contains all
+ *	the explicit assertions closed under the role hierarchy, inverses and
+ *	transitivity. All the edges are stored in a single array sorted by the
+ *	source individual (compressed sparse rows); the edges of an individual
+ *	are sorted by the role and then by the filler.
+ */
+class TRelatedIndex
+{
+public:		// types
+		/// vector of related individuals
+	typedef TRelatedMap::CIVec CIVec;
+		/// vector of RELATED statements
+	typedef std::vector<TRelated*> RelatedVec;
+
+protected:	// types
+		/// single edge <R,J> that starts from some individual
+	struct Edge
+	{
+			/// index of the role
+		unsigned int R;
+			/// the filler
+		const TIndividual* J;
+
+			/// init c'tor
+		Edge ( unsigned int r, const TIndividual* j ) : R(r), J(j) {}
+			/// order edges by the role, then by the filler
+		bool operator < ( const Edge& e ) const { return R < e.R || ( R == e.R && J->index() < e.J->index() ); }
+			/// equality
+		bool operator == ( const Edge& e ) const { return R == e.R && J == e.J; }
+	}; // Edge
+		/// compare edges by the role only
+	struct RoleLess
+	{
+		bool operator() ( const Edge& e, unsigned int r ) const { return e.R < r; }
+		bool operator() ( unsigned int r, const Edge& e ) const { return r < e.R; }
+	}; // RoleLess
+		/// array of edges
+	typedef std::vector<Edge> EdgeVec;
+		/// RO iterator over edges
+	typedef EdgeVec::const_iterator const_iterator;
+		/// range of edges
+	typedef std::pair<const_iterator, const_iterator> EdgeRange;
+
+protected:	// members
+		/// start of the edges of an individual in the Edges; indexed by the individual's index
+	std::vector<unsigned int> Start;
+		/// all the edges
+	EdgeVec Edges;
+		/// true iff the index contains all the entailed assertions
+	bool Complete;
+
+private:	// no copy
+		/// no copy c'tor
+	TRelatedIndex ( const TRelatedIndex& );
+		/// no assignment
+	TRelatedIndex& operator = ( const TRelatedIndex& );
+
+protected:	// methods
+		/// add edges <R,J> and <S,J> for all super-roles S of R to the row OUT
+	static void addEdges ( EdgeVec& out, const TRole* R, const TIndividual* J );
+		/// sort the row OUT and remove duplicates
+	static void sortRow ( EdgeVec& out );
+		/// get R-edges from a given row
+	static EdgeRange getRange ( const EdgeVec& row, unsigned int R )
+		{ return std::equal_range ( row.begin(), row.end(), R, RoleLess() ); }
+		/// add to the rows all the edges implied by the transitivity of R
+	static void closeTransitive ( std::vector<EdgeVec>& rows, const TRole* R );
+
+		/// get all the R-edges of the individual I
+	EdgeRange getRange ( const TIndividual* I, const TRole* R ) const;
+
+public:		// interface
+		/// empty c'tor
+	TRelatedIndex ( void ) : Complete(false) {}
+		/// empty d'tor
+	~TRelatedIndex ( void ) {}
+
+		/// build index for the assertions RELATED with roles from ORM; NC is the upper bound of the individual index
+	void build ( const RelatedVec& Related, const RoleMaster& ORM, unsigned int nC );
+		/// set the completeness flag
+	void setComplete ( bool value ) { Complete = value; }
+		/// @return true iff the index contains all the entailed role assertions
+	bool isComplete ( void ) const { return Complete; }
+		/// @return the number of the indexed assertions
+	size_t size ( void ) const { return Edges.size(); }
+
+		/// @return true iff there is J s.t. R(I,J) is in the index
+	bool hasFillers ( const TIndividual* I, const TRole* R ) const
+	{
+		EdgeRange range = getRange ( I, R );
+		return range.first != range.second;
+	}
+		/// @return true iff R(I,J) is in the index
+	bool isRelated ( const TIndividual* I, const TRole* R, const TIndividual* J ) const;
+		/// add to RESULT all J s.t. R(I,J) is in the index
+	void getFillers ( const TIndividual* I, const TRole* R, CIVec& Result ) const
+	{
+		EdgeRange range = getRange ( I, R );
+		for ( const_iterator p = range.first; p != range.second; ++p )
+			Result.push_back(p->J);
+	}
+}; // TRelatedIndex
+
+#endif
@@ -0,0 +1,249 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TSETASHYBRID_H
+#define TSETASHYBRID_H
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <ostream>
+
+#include "fpp_assert.h"
+
+/**
+ *	Implement model cache set as a sorted vector of indices while the set is
+ *	sparse, and as a bitmap when the vector would take more memory than the
+ *	bitmap. Intersection of two bitmaps is checked a word at a time.
+ */
+class TSetAsHybrid
+{
+protected:	// types
+		/// type of a bitmap word
+	typedef unsigned long Word;
+		/// sorted elements of a sparse set
+	typedef std::vector<unsigned int> ElemVec;
+		/// bitmap of a dense set
+	typedef std::vector<Word> WordVec;
+
+protected:	// members
+		/// elements of the set in the sparse mode
+	ElemVec Elems;
+		/// bitmap of the set in the dense mode; empty in the sparse mode
+	WordVec Bits;
+		/// maximal number of elements
+	unsigned int nElems;
+
+protected:	// methods
+		/// number of bits in a word
+	static unsigned int wordBits ( void ) { return sizeof(Word)*CHAR_BIT; }
+		/// @return the number of words that keeps N bits
+	static size_t nWords ( unsigned int n ) { return (n+wordBits()-1)/wordBits(); }
+		/// @return true iff the set is kept as a bitmap
+	bool isDense ( void ) const { return !Bits.empty(); }
+		/// set bit I in the bitmap; extend bitmap if necessary
+	void setBit ( unsigned int i )
+	{
+		size_t w = i/wordBits();
+		if ( w >= Bits.size() )
+			Bits.resize(w+1,0);
+		Bits[w] |= Word(1) << (i%wordBits());
+	}
+		/// @return true iff bit I is set in the bitmap
+	bool testBit ( unsigned int i ) const
+	{
+		size_t w = i/wordBits();
+		return w < Bits.size() && (Bits[w] & (Word(1) << (i%wordBits()))) != 0;
+	}
+		/// @return true iff sparse set contains I
+	bool sparseContains ( unsigned int i ) const { return std::binary_search ( Elems.begin(), Elems.end(), i ); }
+		/// switch to the dense mode if the vector takes more memory than the bitmap
+	void checkDensity ( void )
+	{
+		unsigned int n = std::max ( nElems, Elems.back()+1 );
+		if ( Elems.size()*sizeof(unsigned int) > nWords(n)*sizeof(Word) )
+			makeDense();
+	}
+		/// move all elements of the sparse set into the bitmap
+	void makeDense ( void )
+	{
+		Bits.resize ( nWords(nElems), 0 );
+		for ( ElemVec::const_iterator p = Elems.begin(), p_end = Elems.end(); p != p_end; ++p )
+			setBit(*p);
+		ElemVec().swap(Elems);
+	}
+		/// @return true iff any element of the sparse set S is in the bitmap B
+	static bool intersectsMixed ( const TSetAsHybrid& s, const TSetAsHybrid& b )
+	{
+		for ( ElemVec::const_iterator p = s.Elems.begin(), p_end = s.Elems.end(); p != p_end; ++p )
+			if ( b.testBit(*p) )
+				return true;
+		return false;
+	}
+
+public:		// interface
+		/// empty c'tor taking max possible number of elements in the set
+	explicit TSetAsHybrid ( unsigned int size ) : nElems(size) {}
+		/// copy c'tor
+	TSetAsHybrid ( const TSetAsHybrid& is ) : Elems(is.Elems), Bits(is.Bits), nElems(is.nElems) {}
+		/// assignment
+	TSetAsHybrid& operator= ( const TSetAsHybrid& is )
+	{
+		Elems = is.Elems;
+		Bits = is.Bits;
+		nElems = is.nElems;
+		return *this;
+	}
+		/// empty d'tor
+	~TSetAsHybrid ( void ) {}
+
+		/// adds given index to the set
+	void insert ( unsigned int i )
+	{
+#	ifdef ENABLE_CHECKING
+		fpp_assert ( i > 0 );
+#	endif
+		if ( isDense() )
+		{
+			setBit(i);
+			return;
+		}
+		ElemVec::iterator p = std::lower_bound ( Elems.begin(), Elems.end(), i );
+		if ( p != Elems.end() && *p == i )
+			return;
+		Elems.insert ( p, i );
+		checkDensity();
+	}
+		/// completes the set with [1,n)
+	void completeSet ( void )
+	{
+		if ( nElems <= 1 )	// nothing to add
+			return;
+		if ( !isDense() )
+			makeDense();
+		for ( unsigned int i = 1; i < nElems; ++i )
+			setBit(i);
+	}
+		/// adds the given set to the current one
+	TSetAsHybrid& operator |= ( const TSetAsHybrid& is )
+	{
+		if ( is.isDense() )
+		{
+			if ( !isDense() )
+				makeDense();
+			if ( Bits.size() < is.Bits.size() )
+				Bits.resize ( is.Bits.size(), 0 );
+			for ( size_t i = 0, n = is.Bits.size(); i < n; ++i )
+				Bits[i] |= is.Bits[i];
+		}
+		else if ( isDense() )
+		{
+			for ( ElemVec::const_iterator p = is.Elems.begin(), p_end = is.Elems.end(); p != p_end; ++p )
+				setBit(*p);
+		}
+		else if ( !is.Elems.empty() )
+		{
+			ElemVec res;
+			res.reserve ( Elems.size() + is.Elems.size() );
+			std::set_union ( Elems.begin(), Elems.end(), is.Elems.begin(), is.Elems.end(), std::back_inserter(res) );
+			Elems.swap(res);
+			checkDensity();
+		}
+		return *this;
+	}
+		/// clear the set
+	void clear ( void )
+	{
+		Elems.clear();
+		Bits.clear();
+	}
+
+		/// check whether the set is empty
+	bool empty ( void ) const { return Elems.empty() && !isDense(); }
+		/// check whether I contains in the set
+	bool contains ( unsigned int i ) const { return isDense() ? testBit(i) : sparseContains(i); }
+		/// check whether the intersection between the current set and IS is nonempty
+	bool intersects ( const TSetAsHybrid& is ) const
+	{
+		if ( isDense() )
+		{
+			if ( !is.isDense() )
+				return intersectsMixed ( is, *this );
+			for ( size_t i = 0, n = std::min ( Bits.size(), is.Bits.size() ); i < n; ++i )
+				if ( Bits[i] & is.Bits[i] )
+					return true;
+			return false;
+		}
+		if ( is.isDense() )
+			return intersectsMixed ( *this, is );
+
+		// both sets are sparse
+		if ( Elems.empty() || is.Elems.empty() || Elems.back() < is.Elems.front() || is.Elems.back() < Elems.front() )
+			return false;
+
+		ElemVec::const_iterator p1 = Elems.begin(), p1_end = Elems.end(), p2 = is.Elems.begin(), p2_end = is.Elems.end();
+		while ( p1 != p1_end && p2 != p2_end )
+			if ( *p1 == *p2 )
+				return true;
+			else if ( *p1 < *p2 )
+				++p1;
+			else
+				++p2;
+
+		return false;
+	}
+		/// put all the elements of the set into OUT in the increasing order
+	void getElements ( std::vector<unsigned int>& out ) const
+	{
+		if ( !isDense() )
+		{
+			out.insert ( out.end(), Elems.begin(), Elems.end() );
+			return;
+		}
+		for ( size_t w = 0, n = Bits.size(); w < n; ++w )
+			for ( Word b = Bits[w], i = 0; b != 0; b >>= 1, ++i )
+				if ( b & 1 )
+					out.push_back ( w*wordBits() + i );
+	}
+		/// prints the set in a human-readable form
+	void print ( std::ostream& o ) const
+	{
+		std::vector<unsigned int> elems;
+		getElements(elems);
+		o << "{";
+		for ( std::vector<unsigned int>::const_iterator p = elems.begin(), p_end = elems.end(); p != p_end; ++p )
+			o << (p == elems.begin() ? "" : ",") << *p;
+		o << "}";
+	}
+
+		/// size of a set
+	size_t size ( void ) const
+	{
+		if ( !isDense() )
+			return Elems.size();
+		size_t ret = 0;
+		for ( WordVec::const_iterator p = Bits.begin(), p_end = Bits.end(); p != p_end; ++p )
+			for ( Word b = *p; b != 0; b &= b-1 )
+				++ret;
+		return ret;
+	}
+		/// maximal size of a set
+	unsigned int maxSize ( void ) const { return nElems; }
+}; // TSetAsHybrid
+
+#endif
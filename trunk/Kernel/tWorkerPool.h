@@ -0,0 +1,190 @@
+/* This file is part of the FaCT++ DL reasoner
+Copyright (C) 2014 by Dmitry Tsarkov
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef TWORKERPOOL_H
+#define TWORKERPOOL_H
+
+#include <pthread.h>
+#include <vector>
+
+#include "eFaCTPlusPlus.h"
+#include "tMutex.h"
+#include "tCancelToken.h"
+
+/**
+ *	Fixed-size pool of worker threads. The pool processes batches of jobs:
+ *	the caller publishes a job with N items, every worker takes the next
+ *	unprocessed item, and the caller waits until all items are done. Every
+ *	worker has its own index, so the job may keep per-thread data.
+ */
+class TWorkerPool
+{
+public:		// types
+		/// interface for a batch job to be run in the pool
+	class Job
+	{
+	public:		// interface
+			/// empty c'tor
+		Job ( void ) {}
+			/// empty d'tor
+		virtual ~Job ( void ) {}
+			/// process ITEM of the job in the thread with index WORKER; shall not throw
+		virtual void process ( unsigned int worker, unsigned int item ) = 0;
+	}; // Job
+
+protected:	// types
+		/// data that is passed to a worker thread
+	struct WorkerInfo
+	{
+			/// pool the worker belongs to
+		TWorkerPool* pool;
+			/// index of the worker
+		unsigned int index;
+	}; // WorkerInfo
+
+protected:	// members
+		/// all worker threads
+	std::vector<pthread_t> Threads;
+		/// all worker infos
+	std::vector<WorkerInfo> Infos;
+		/// lock that protects the state of the pool
+	TMutex Lock;
+		/// condition that signals a new batch or a shutdown
+	pthread_cond_t WorkReady;
+		/// condition that signals the end of the batch
+	pthread_cond_t WorkDone;
+		/// current job (if any)
+	Job* curJob;
+		/// token of the operation the current job works for (if any)
+	TCancelToken* curToken;
+		/// number of items in the current job
+	unsigned int nItems;
+		/// index of the next item to process
+	unsigned int nextItem;
+		/// number of processed items
+	unsigned int nDone;
+		/// true iff the pool is shutting down
+	bool shutdown;
+
+private:	// no copy
+		/// no copy c'tor
+	TWorkerPool ( const TWorkerPool& );
+		/// no assignment
+	TWorkerPool& operator = ( const TWorkerPool& );
+
+protected:	// methods
+		/// main loop of the worker with a given INDEX
+	void workerLoop ( unsigned int index )
+	{
+		Lock.lock();
+		for (;;)
+		{
+			while ( !shutdown && ( curJob == NULL || nextItem >= nItems ) )
+				pthread_cond_wait ( &WorkReady, Lock.get() );
+			if ( shutdown )
+				break;
+			Job* job = curJob;
+			unsigned int item = nextItem++;
+			TCancelToken* token = curToken;
+			Lock.unlock();
+			{
+				// the worker serves the operation of the caller
+				TCancelTokenScope scope(token);
+				job->process ( index, item );
+			}
+			Lock.lock();
+			if ( ++nDone == nItems )
+				pthread_cond_signal(&WorkDone);
+		}
+		Lock.unlock();
+	}
+		/// entry point of the worker thread
+	static void* startWorker ( void* arg )
+	{
+		WorkerInfo* info = static_cast<WorkerInfo*>(arg);
+		info->pool->workerLoop(info->index);
+		return NULL;
+	}
+
+public:		// interface
+		/// c'tor: create N worker threads
+	TWorkerPool ( unsigned int n )
+		: Threads(n)
+		, Infos(n)
+		, curJob(NULL)
+		, curToken(NULL)
+		, nItems(0)
+		, nextItem(0)
+		, nDone(0)
+		, shutdown(false)
+	{
+		pthread_cond_init ( &WorkReady, NULL );
+		pthread_cond_init ( &WorkDone, NULL );
+		for ( unsigned int i = 0; i < n; ++i )
+		{
+			Infos[i].pool = this;
+			Infos[i].index = i;
+			if ( pthread_create ( &Threads[i], NULL, startWorker, &Infos[i] ) != 0 )
+			{
+				// keep only the threads that were actually started
+				Threads.resize(i);
+				stop();
+				throw EFaCTPlusPlus("FaCT++ Kernel: can't create worker thread");
+			}
+		}
+	}
+		/// d'tor: stop all the workers
+	~TWorkerPool ( void ) { stop(); }
+
+		/// get the number of workers
+	unsigned int size ( void ) const { return Threads.size(); }
+		/// process N items of the JOB; return when all items are processed
+	void run ( Job& job, unsigned int n )
+	{
+		if ( n == 0 )
+			return;
+		TMutexLock lock(Lock);
+		curJob = &job;
+		curToken = TCancelToken::getCurrent();
+		nItems = n;
+		nextItem = 0;
+		nDone = 0;
+		pthread_cond_broadcast(&WorkReady);
+		while ( nDone < nItems )
+			pthread_cond_wait ( &WorkDone, Lock.get() );
+		curJob = NULL;
+		curToken = NULL;
+	}
+		/// stop all the workers; no jobs could be run after that
+	void stop ( void )
+	{
+		if ( shutdown )
+			return;
+		Lock.lock();
+		shutdown = true;
+		pthread_cond_broadcast(&WorkReady);
+		Lock.unlock();
+		for ( std::vector<pthread_t>::iterator p = Threads.begin(), p_end = Threads.end(); p != p_end; ++p )
+			pthread_join ( *p, NULL );
+		Threads.clear();
+		pthread_cond_destroy(&WorkReady);
+		pthread_cond_destroy(&WorkDone);
+	}
+}; // TWorkerPool
+
+#endif